@@ -1,6 +1,8 @@
 #include "app.h"
 #include "appconfig.h"
 #include "engine/engine.h"
+#include "engine/alloctracker.h"
+#include "engine/startuptimeline.h"
 #include "app_state/game.h"
 #include "app_state/menu.h"
 
@@ -27,26 +29,67 @@ App::~App()
 void App::run()
 {
     is_running = true;
-    //inicjalizacja SDL i utworzenie okan
+    StartupTimeline::start();
+
+    Engine& engine = Engine::getEngine();
+    engine.createModules();
+    Renderer* renderer = engine.getRenderer();
 
-    if(SDL_Init(SDL_INIT_VIDEO) == 0)
+    //inicjalizacja SDL i utworzenie okan
+    StartupTimeline::begin(SS_SDL_INIT);
+    int sdl_init = SDL_Init(SDL_INIT_VIDEO);
+    StartupTimeline::end(SS_SDL_INIT);
+    if(sdl_init == 0)
     {
+        //etapy niezależne od okna są wykonywane w osobnych wątkach równolegle z tworzeniem okna i renderera;
+        //wątki SDL (pulę i zadania) można tworzyć dopiero po udanym SDL_Init, a destruktory zadań czekają na nie przy każdym wyjściu z bloku
+        engine.createThreadPool();
+        renderer->openAssets();
+        StartupTask texture_task(SS_TEXTURE, [renderer]{ renderer->prepareTexture(); });
+        StartupTask font_task(SS_FONT, [renderer]{ renderer->prepareFont(); });
+        StartupTask sprites_task(SS_SPRITES, [&engine]{ engine.loadSpriteConfig(); });
+        StartupTask levels_task(SS_LEVELS, [&engine]{ engine.openLevelPack(); });
+
+        StartupTimeline::begin(SS_WINDOW);
         m_window = SDL_CreateWindow("TANKS", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                     AppConfig::windows_rect.w, AppConfig::windows_rect.h, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+        StartupTimeline::end(SS_WINDOW);
 
-        if(m_window == nullptr) return;
-
-        if(!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return;
-        if(TTF_Init() == -1) return;
+        if(m_window == nullptr)
+        {
+            //etapy uruchamiania korzystają z modułów silnika, więc moduły są niszczone dopiero po ich zakończeniu
+            texture_task.join();
+            font_task.join();
+            sprites_task.join();
+            levels_task.join();
+            engine.destroyModules();
+            SDL_Quit();
+            return;
+        }
+        //SDL_image i SDL_ttf są inicjowane przez Renderer tylko wtedy, gdy brakuje pliku zasobów
 
         srand(time(NULL)); //inicjowanie generatora pseudolosowego
 
-        Engine& engine = Engine::getEngine();
-        engine.initModules();
-        engine.getRenderer()->loadTexture(m_window);
-        engine.getRenderer()->loadFont();
-
+        StartupTimeline::begin(SS_RENDERER);
+        renderer->createRenderer(m_window);
+        StartupTimeline::end(SS_RENDERER);
+
+        //tekstury wymagają renderera oraz przygotowanych danych
+        texture_task.join();
+        font_task.join();
+        StartupTimeline::begin(SS_UPLOAD);
+        renderer->uploadTextures();
+        StartupTimeline::end(SS_UPLOAD);
+
+        //menu korzysta z animacji i zleca wczytanie pierwszego poziomu
+        sprites_task.join();
+        levels_task.join();
+        engine.getSpriteConfig()->insertAtlas(renderer->getSpriteAtlas());
+        StartupTimeline::begin(SS_MENU);
         m_app_state = new Menu;
+        StartupTimeline::end(SS_MENU);
+        StartupTimeline::begin(SS_FIRST_FRAME);
+        bool first_frame = true;
 
         double FPS;
         Uint32 time1, time2, dt, fps_time = 0, fps_count = 0, delay = 15;
@@ -65,10 +108,21 @@ void App::run()
             }
             if(m_app_state == nullptr) break;
 
+            engine.getFrameArena()->reset(); //teksty poprzedniej klatki nie są już potrzebne
+            AllocTracker::nextFrame();
             eventProces();
 
             m_app_state->update(dt);
+            AllocTracker::setPhase(AP_DRAW);
             m_app_state->draw();
+            AllocTracker::setPhase(AP_OTHER);
+
+            if(first_frame)
+            {
+                StartupTimeline::end(SS_FIRST_FRAME);
+                if(AppConfig::startup_report) StartupTimeline::report(std::cout);
+                first_frame = false;
+            }
 
             SDL_Delay(delay);
 
@@ -84,7 +138,9 @@ void App::run()
         }
 
         engine.destroyModules();
+        if(AllocTracker::enabled()) AllocTracker::report(std::cout);
     }
+    else engine.destroyModules(); //bez SDL nie powstał żaden wątek, ale Renderer i arena klatki już istnieją
 
     SDL_DestroyWindow(m_window);
     m_window = nullptr;
@@ -1,5 +1,8 @@
 #include "game.h"
 #include "../engine/engine.h"
+#include "../engine/alloctracker.h"
+#include "../engine/levelpack.h"
+#include "../engine/levelgenerator.h"
 #include "../appconfig.h"
 #include "menu.h"
 #include "scores.h"
@@ -11,11 +14,13 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <limits>
 
 Game::Game()
 {
     m_level_columns_count = 0;
     m_level_rows_count = 0;
+    m_level_revision = 0;
     m_current_level = 0;
     m_eagle = nullptr;
     m_player_count = 1;
@@ -24,7 +29,12 @@ Game::Game()
     m_level_end_time = 0;
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
+    m_tile_frame_time = 0;
+    m_tile_frame = 0;
     m_enemy_respown_position = 0;
+    m_spawned_count = 0;
+    m_roster_spawned = 0;
+    resetPhaseTimes();
     nextLevel();
 }
 
@@ -32,6 +42,7 @@ Game::Game(int players_count)
 {
     m_level_columns_count = 0;
     m_level_rows_count = 0;
+    m_level_revision = 0;
     m_current_level = 0;
     m_eagle = nullptr;
     m_player_count = players_count;
@@ -39,30 +50,67 @@ Game::Game(int players_count)
     m_level_end_time = 0;
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
+    m_tile_frame_time = 0;
+    m_tile_frame = 0;
     m_enemy_respown_position = 0;
+    m_spawned_count = 0;
+    m_roster_spawned = 0;
+    resetPhaseTimes();
     nextLevel();
 }
 
+Game::Game(int players_count, std::shared_ptr<const LevelTemplate> level_template, int level)
+{
+    m_level_columns_count = 0;
+    m_level_rows_count = 0;
+    m_level_revision = 0;
+    m_current_level = level;
+    m_eagle = nullptr;
+    m_player_count = players_count;
+    m_pause = false;
+    m_level_end_time = 0;
+    m_protect_eagle = false;
+    m_protect_eagle_time = 0;
+    m_tile_frame_time = 0;
+    m_tile_frame = 0;
+    m_enemy_respown_position = 0;
+    m_spawned_count = 0;
+    m_roster_spawned = 0;
+    resetPhaseTimes();
+    startLevel(level_template);
+}
+
 Game::Game(std::vector<Player *> players, int previous_level)
 {
     m_level_columns_count = 0;
     m_level_rows_count = 0;
+    m_level_revision = 0;
     m_current_level = previous_level;
     m_eagle = nullptr;
-    m_players = players;
-    m_player_count = m_players.size();
-    for(auto player : m_players)
+    for(auto player : players)
     {
-        player->clearFlag(TSF_MENU);
-        player->lives_count++;
-        player->respawn();
+        player->attach(&m_tanks);
+        m_players.insert(player);
     }
+    m_player_count = m_players.size();
     m_pause = false;
     m_level_end_time = 0;
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
+    m_tile_frame_time = 0;
+    m_tile_frame = 0;
     m_enemy_respown_position = 0;
+    m_spawned_count = 0;
+    m_roster_spawned = 0;
+    resetPhaseTimes();
     nextLevel();
+    //gracze odradzają się w położeniach startowych nowego poziomu
+    for(auto player : m_players)
+    {
+        player->clearFlag(TSF_MENU);
+        player->lives_count++;
+        player->respawn();
+    }
 }
 
 Game::~Game()
@@ -78,18 +126,31 @@ void Game::draw()
 
     if(m_level_start_screen)
     {
-        std::string level_name = "STAGE " + Engine::intToString(m_current_level);
-        renderer->drawText(nullptr, level_name, {255, 255, 255, 255}, 1);
+        renderer->drawText(nullptr, engine.frameText("STAGE ", m_current_level), {255, 255, 255, 255}, 1);
     }
     else
     {
         renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 0}, true);
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->draw();
+        for(int i = 0; i < m_level_rows_count; i++)
+            for(int j = 0; j < m_level_columns_count; j++)
+                tileAt(i, j).draw(i, j, m_tile_frame);
+
+        //pod koniec działania łopaty kamienny mur miga murkiem z cegieł; zmienia się tylko wygląd, kolizje pozostają bez zmian
+        if(m_protect_eagle && m_protect_eagle_time > AppConfig::protect_eagle_time / 4 * 3 && m_protect_eagle_time / AppConfig::bonus_blink_time % 2)
+        {
+            const SDL_Rect* brick_src = &engine.getSpriteConfig()->getSpriteData(ST_BRICK_WALL)->rect;
+            for(auto& cell : m_level_template->eagle_wall)
+            {
+                if(tileAt(cell.y, cell.x).empty()) continue;
+                SDL_Rect dest = Tile::destRect(cell.y, cell.x);
+                renderer->drawRect(&dest, {0, 0, 0, 0}, true);
+                renderer->drawObject(brick_src, &dest);
+            }
+        }
 
         for(auto player : m_players) player->draw();
         for(auto enemy : m_enemies) enemy->draw();
+        m_bullets.draw();
         for(auto bush : m_bushes) bush->draw();
         for(auto bonus : m_bonuses) bonus->draw();
         m_eagle->draw();
@@ -99,7 +160,7 @@ void Game::draw()
             SDL_Point pos;
             pos.x = -1;
             pos.y = m_game_over_position;
-            renderer->drawText(&pos, AppConfig::game_over_text, {255, 10, 10, 255});
+            renderer->drawText(&pos, AppConfig::game_over_text.c_str(), {255, 10, 10, 255});
         }
 
         //===========Status gry===========
@@ -120,26 +181,52 @@ void Game::draw()
             p_dst = {dst.x + dst.w + 2, dst.y + 3};
             i++;
             renderer->drawObject(&player->src_rect, &dst);
-            renderer->drawText(&p_dst, Engine::intToString(player->lives_count), {0, 0, 0, 255}, 3);
+            renderer->drawText(&p_dst, engine.frameText("", player->lives_count), {0, 0, 0, 255}, 3);
         }
         //numer mapy
         src = engine.getSpriteConfig()->getSpriteData(ST_STAGE_STATUS)->rect;
         dst = {AppConfig::status_rect.x + 8, static_cast<int>(185 + (m_players.size() + m_killed_players.size()) * 18), src.w, src.h};
         p_dst = {dst.x + 10, dst.y + 26};
         renderer->drawObject(&src, &dst);
-        renderer->drawText(&p_dst, Engine::intToString(m_current_level), {0, 0, 0, 255}, 2);
+        renderer->drawText(&p_dst, engine.frameText("", m_current_level), {0, 0, 0, 255}, 2);
 
         if(m_pause)
-            renderer->drawText(nullptr, std::string("PAUSE"), {200, 0, 0, 255}, 1);
+            renderer->drawText(nullptr, "PAUSE", {200, 0, 0, 255}, 1);
+
+#ifdef ALLOC_TRACKING
+        //przydziały pamięci w poprzedniej klatce: liczba wywołań new i liczba bajtów dla każdej fazy
+        for(int k = 0; k < AP_COUNT; k++)
+        {
+            AllocStats stats = AllocTracker::lastFrame(static_cast<AllocPhase>(k));
+            p_dst = {4, 4 + k * 12};
+            renderer->drawText(&p_dst, AllocTracker::phaseName(static_cast<AllocPhase>(k)), {255, 255, 0, 255}, 3);
+            p_dst.x = 110;
+            renderer->drawText(&p_dst, engine.frameText("", stats.allocations), {255, 255, 0, 255}, 3);
+            p_dst.x = 150;
+            renderer->drawText(&p_dst, engine.frameText("", stats.bytes), {255, 255, 0, 255}, 3);
+        }
+#endif
     }
 
     renderer->flush();
 }
 
+/**
+ * Dodanie czasu od @a start do @a total i rozpoczęcie pomiaru kolejnej fazy.
+ */
+static void addPhaseTime(Uint64& total, Uint64& start)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    total += now - start;
+    start = now;
+}
+
 void Game::update(Uint32 dt)
 {
     if(dt > 40) return;
 
+    if(m_level_watcher.poll()) reloadLevel();
+
     if(m_level_start_screen)
     {
         if(m_level_start_time > AppConfig::level_start_time)
@@ -151,105 +238,89 @@ void Game::update(Uint32 dt)
     {
         if(m_pause) return;
 
-        std::vector<Player*>::iterator pl1, pl2;
-        std::vector<Enemy*>::iterator en1, en2;
-
-        //sprawdzenie kolizji czołgów graczy ze sobą
-        for(pl1 = m_players.begin(); pl1 != m_players.end(); pl1++)
-            for(pl2 = pl1 + 1; pl2 != m_players.end(); pl2++)
-                checkCollisionTwoTanks(*pl1, *pl2, dt);
-
-
-        //sprawdzenie kolizji czołgów przeciwników ze sobą
-        for(en1 = m_enemies.begin(); en1 != m_enemies.end(); en1++)
-             for(en2 = en1 + 1; en2 != m_enemies.end(); en2++)
-                checkCollisionTwoTanks(*en1, *en2, dt);
-
-        //sprawdzenie kolizji kuli z lewelem
-        for(auto enemy : m_enemies)
-            for(auto bullet : enemy->bullets)
-                checkCollisionBulletWithLevel(bullet);
-        for(auto player : m_players)
-            for(auto bullet : player->bullets)
-            {
-                checkCollisionBulletWithLevel(bullet);
-                checkCollisionBulletWithBush(bullet);
-            }
-
+#ifdef ALLOC_ASSERT
+        Uint32 allocations = AllocTracker::frameAllocations();
+        unsigned spawned_count = m_spawned_count, enemies_count = m_enemies.size(), bonuses_count = m_bonuses.size(), players_count = m_players.size();
+        bool steady = !m_game_over && m_level_time > AppConfig::alloc_assert_warmup_time;
+        unsigned pool_heap_allocations = Enemy::pool.heapAllocations() + Bonus::pool.heapAllocations();
+#endif
+        m_level_time += dt;
+
+        //wykrywanie kolizji jest równoległe, a rozstrzyganie szeregowe w ustalonej kolejności
+        AllocTracker::setPhase(AP_COLLISION);
+        Uint64 phase_start = SDL_GetPerformanceCounter();
+        detectContacts();
+        addPhaseTime(m_phase_times.detect_contacts, phase_start);
+        resolveContacts();
+        addPhaseTime(m_phase_times.resolve_contacts, phase_start);
+        updateTankLimits(dt);
+        addPhaseTime(m_phase_times.tank_limits, phase_start);
+
+        AllocTracker::setPhase(AP_OBJECT_UPDATE);
+        m_players_indexed = false;
+        runEnemyDecisions();
+        addPhaseTime(m_phase_times.enemy_decisions, phase_start);
+        m_phase_times.updates++;
+        //pociski przeciwników wystrzelone w tej klatce lecą od razu, a pociski graczy (strzelających w Player::update) od następnej klatki
+        m_bullets.update(dt);
+        //ruch, czasy i animacja wszystkich czołgów; obiekty czołgów obsługują wynik kroku w swoich funkcjach update
+        m_tanks.update(dt);
 
-        for(auto player : m_players)
-            for(auto enemy : m_enemies)
+        //Update wszystkich obiektów
+        //usunięty element zastępuje ostatni z kontenera, który jeszcze nie był aktualizowany
+        for(unsigned i = 0; i < m_enemies.size();)
+        {
+            Enemy* enemy = m_enemies.at(i);
+            enemy->update(dt);
+            if(enemy->to_erase)
             {
-                //sprawdzenie kolizji czołgów przeciwników z graczami
-                checkCollisionTwoTanks(player, enemy, dt);
-                //sprawdzenie kolizji pocisków gracza z przeciwnikiem
-                checkCollisionPlayerBulletsWithEnemy(player, enemy);
-
-                //sprawdzenie kolizji pocisku gracza z pociskiem przeciwnika
-                for(auto bullet1 : player->bullets)
-                     for(auto bullet2 : enemy->bullets)
-                            checkCollisionTwoBullets(bullet1, bullet2);
+                delete enemy;
+                m_enemies.eraseAt(i);
             }
-
-        //sprawdzenie kolizji pocisku przeciknika z graczem
-        for(auto enemy : m_enemies)
-            for(auto player : m_players)
-                    checkCollisionEnemyBulletsWithPlayer(enemy, player);
-
-        //sprawdzanie kolizji gracza z bunusem
-        for(auto player : m_players)
-            for(auto bonus : m_bonuses)
-                checkCollisionPlayerWithBonus(player, bonus);
-
-        //Sprawdzenie kolizji czołgów z poziomem
-        for(auto enemy : m_enemies) checkCollisionTankWithLevel(enemy, dt);
-        for(auto player : m_players) checkCollisionTankWithLevel(player, dt);
-
-        //nadanie celów przeciwników
-        int min_metric; // 2 * 26 * 16
-        int metric;
-        SDL_Point target;
-        for(auto enemy : m_enemies)
+            else i++;
+        }
+        for(auto player : m_players) player->update(dt);
+        m_bullets.eraseFinished();
+        for(unsigned i = 0; i < m_bonuses.size();)
         {
-            min_metric = 832;
-            if(enemy->type == ST_TANK_A || enemy->type == ST_TANK_D)
-                for(auto player : m_players)
-                {
-                    metric = fabs(player->dest_rect.x - enemy->dest_rect.x) + fabs(player->dest_rect.y - enemy->dest_rect.y);
-                    if(metric < min_metric)
-                    {
-                        min_metric = metric;
-                        target = {player->dest_rect.x + player->dest_rect.w / 2, player->dest_rect.y + player->dest_rect.h / 2};
-                    }
-                }
-            metric = fabs(m_eagle->dest_rect.x - enemy->dest_rect.x) + fabs(m_eagle->dest_rect.y - enemy->dest_rect.y);
-            if(metric < min_metric)
+            Bonus* bonus = m_bonuses.at(i);
+            bonus->update(dt);
+            if(bonus->to_erase)
             {
-                min_metric = metric;
-                target = {m_eagle->dest_rect.x + m_eagle->dest_rect.w / 2, m_eagle->dest_rect.y + m_eagle->dest_rect.h / 2};
+                delete bonus;
+                m_bonuses.eraseAt(i);
             }
-
-            enemy->target_position = target;
+            else i++;
         }
-
-        //Update wszystkich obiektów
-        for(auto enemy : m_enemies) enemy->update(dt);
-        for(auto player : m_players) player->update(dt);
-        for(auto bonus : m_bonuses) bonus->update(dt);
         m_eagle->update(dt);
 
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->update(dt);
+        //animacja pól mapy (wody)
+        const SpriteData* water = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_WATER);
+        m_tile_frame_time += dt;
+        if(m_tile_frame_time > water->frame_duration)
+        {
+            m_tile_frame_time = 0;
+            m_tile_frame = (m_tile_frame + 1) % water->frames_count;
+        }
 
 
         for(auto bush : m_bushes) bush->update(dt);
 
         //usunięcie niepotrzebnych elementów
-        m_enemies.erase(std::remove_if(m_enemies.begin(), m_enemies.end(), [](Enemy*e){if(e->to_erase) {delete e; return true;} return false;}), m_enemies.end());
-        m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [this](Player*p){if(p->to_erase) {m_killed_players.push_back(p); return true;} return false;}), m_players.end());
-        m_bonuses.erase(std::remove_if(m_bonuses.begin(), m_bonuses.end(), [](Bonus*b){if(b->to_erase) {delete b; return true;} return false;}), m_bonuses.end());
-        m_bushes.erase(std::remove_if(m_bushes.begin(), m_bushes.end(), [](Object*b){if(b->to_erase) {delete b; return true;} return false;}), m_bushes.end());
+        AllocTracker::setPhase(AP_CLEANUP);
+        for(unsigned i = 0; i < m_players.size();)
+        {
+            Player* player = m_players.at(i);
+            if(player->to_erase)
+            {
+                player->attach(&m_killed_tanks);
+                m_killed_players.push_back(player);
+                m_players.eraseAt(i);
+            }
+            else i++;
+        }
+        m_bushes.erase(std::remove_if(m_bushes.begin(), m_bushes.end(), [](Object*b){return b->to_erase;}), m_bushes.end());
+        AllocTracker::setPhase(AP_OTHER);
 
         //dodanie nowego przeciwnika
         m_enemy_redy_time += dt;
@@ -282,67 +353,25 @@ void Game::update(Uint32 dt)
         if(m_protect_eagle)
         {
             m_protect_eagle_time += dt;
-            if(m_protect_eagle_time > AppConfig::protect_eagle_time)
-            {
-                m_protect_eagle = false;
-                m_protect_eagle_time = 0;
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
-            }
-
-            if(m_protect_eagle && m_protect_eagle_time > AppConfig::protect_eagle_time / 4 * 3 && m_protect_eagle_time / AppConfig::bonus_blink_time % 2)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
-            }
-            else if(m_protect_eagle)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
+            if(m_protect_eagle_time > AppConfig::protect_eagle_time) removeEagleWall();
+        }
 
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-            }
+#ifdef ALLOC_ASSERT
+        //pojawienie się lub zniknięcie obiektu (nowy przeciwnik, bonus, zniszczony czołg) nie jest stanem ustalonym
+        steady = steady && spawned_count == m_spawned_count && enemies_count == m_enemies.size() && bonuses_count == m_bonuses.size() && players_count == m_players.size();
+        if(steady && AllocTracker::frameAllocations() != allocations)
+        {
+            std::cerr << "heap allocation in a steady-state level tick" << std::endl;
+            AllocTracker::printFrame(std::cerr);
+            abort();
         }
+        //przydział ze sterty przez pulę oznacza zbyt małą pulę, również w klatce, w której pojawia się nowy obiekt
+        if(Enemy::pool.heapAllocations() + Bonus::pool.heapAllocations() != pool_heap_allocations)
+        {
+            std::cerr << "object pool exhausted: enemies " << Enemy::pool.heapAllocations() << ", bonuses " << Bonus::pool.heapAllocations() << " heap allocations" << std::endl;
+            abort();
+        }
+#endif
     }
 }
 
@@ -374,66 +403,398 @@ void Game::eventProcess(SDL_Event *ev)
     }
 }
 
-/*
-. = puste pole
-# = murek
-@ = kamień
-% = krzaki
-~ = woda
-- = lód
- */
+const Game::PhaseTimes& Game::phaseTimes() const
+{
+    return m_phase_times;
+}
 
-void Game::loadLevel(std::string path)
+void Game::resetPhaseTimes()
 {
-    std::fstream level(path, std::ios::in);
-    std::string line;
-    int j = -1;
+    m_phase_times = PhaseTimes{0, 0, 0, 0, 0};
+}
+
+bool Game::Contact::operator<(const Contact &c) const
+{
+    if(type != c.type) return type < c.type;
+    if(first != c.first) return first < c.first;
+    if(second != c.second) return second < c.second;
+    if(third != c.third) return third < c.third;
+    return fourth < c.fourth;
+}
+
+Tank* Game::tankAt(int index) const
+{
+    if(index < static_cast<int>(m_enemies.size())) return m_enemies.at(index);
+    return m_players.at(index - m_enemies.size());
+}
+
+void Game::detectContacts()
+{
+    ThreadPool* pool = Engine::getEngine().getThreadPool();
+    m_worker_contacts.resize(pool->size());
+    //zapas miejsca sprawia, że w typowej klatce zbieranie kontaktów nie odwołuje się do sterty
+    for(auto& contacts : m_worker_contacts)
+    {
+        contacts.clear();
+        contacts.reserve(contacts_reserve);
+    }
 
-    if(level.is_open())
+    int tanks_count = m_enemies.size() + m_players.size();
+    int pairs_count = m_players.size() * m_enemies.size();
+    int bonus_pairs_count = m_players.size() * m_bonuses.size();
+
+    //zadania: pociski każdego czołgu z poziomem, każda para gracz-przeciwnik, każda para gracz-bonus
+    pool->parallelFor(tanks_count + pairs_count + bonus_pairs_count, [this, tanks_count, pairs_count](int k, unsigned worker)
     {
-        while(!level.eof())
+        std::vector<Contact>& contacts = m_worker_contacts.at(worker);
+        SDL_Rect intersect_rect;
+
+        if(k < tanks_count)
         {
-            std::getline(level, line);
-            std::vector<Object*> row;
-            j++;
-            for(unsigned i = 0; i < line.size(); i++)
+            Tank* tank = tankAt(k);
+            bool player = k >= static_cast<int>(m_enemies.size());
+            for(unsigned b = 0; b < tank->bullets.size(); b++)
             {
-                Object* obj;
-                switch(line.at(i))
+                int bullet = bulletOf(tank, b);
+                if(detectCollisionBulletWithLevel(bullet))
+                    contacts.push_back({CT_BULLET_LEVEL, k, static_cast<int>(b), 0, 0});
+                if(player && detectCollisionBulletWithBush(bullet))
+                    contacts.push_back({CT_BULLET_BUSH, k - static_cast<int>(m_enemies.size()), static_cast<int>(b), 0, 0});
+            }
+            return;
+        }
+
+        k -= tanks_count;
+        if(k < pairs_count)
+        {
+            int p = k / m_enemies.size(), e = k % m_enemies.size();
+            Player* pl = m_players.at(p);
+            Enemy* en = m_enemies.at(e);
+
+            if(!pl->to_erase && !en->to_erase)
+            {
+                //flagi trafianego czołgu są odczytywane z magazynu tylko wtedy, gdy drugi czołg ma pociski
+                if(!pl->bullets.empty() && !en->testFlag(TSF_DESTROYED))
+                    for(unsigned b = 0; b < pl->bullets.size(); b++)
+                    {
+                        int bullet = bulletOf(pl, b);
+                        if(bullet < 0 || m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE)) continue;
+                        SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+                        intersect_rect = intersectRect(&bullet_rect, &en->collision_rect);
+                        if(intersect_rect.w > 0 && intersect_rect.h > 0)
+                        {
+                            contacts.push_back({CT_PLAYER_BULLETS_ENEMY, p, e, 0, 0});
+                            break;
+                        }
+                    }
+                if(!en->bullets.empty() && !pl->testFlag(TSF_DESTROYED))
+                    for(unsigned b = 0; b < en->bullets.size(); b++)
+                    {
+                        int bullet = bulletOf(en, b);
+                        if(bullet < 0 || m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE)) continue;
+                        SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+                        intersect_rect = intersectRect(&bullet_rect, &pl->collision_rect);
+                        if(intersect_rect.w > 0 && intersect_rect.h > 0)
+                        {
+                            contacts.push_back({CT_ENEMY_BULLETS_PLAYER, e, p, 0, 0});
+                            break;
+                        }
+                    }
+            }
+
+            for(unsigned b1 = 0; b1 < pl->bullets.size(); b1++)
+                for(unsigned b2 = 0; b2 < en->bullets.size(); b2++)
                 {
-                case '#' : obj = new Brick(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h); break;
-                case '@' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_STONE_WALL); break;
-                case '%' : m_bushes.push_back(new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_BUSH)); obj =  nullptr; break;
-                case '~' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_WATER); break;
-                case '-' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_ICE); break;
-                default: obj = nullptr;
+                    int bullet1 = bulletOf(pl, b1), bullet2 = bulletOf(en, b2);
+                    if(bullet1 < 0 || bullet2 < 0) continue;
+                    SDL_Rect rect1 = m_bullets.collisionRect(bullet1), rect2 = m_bullets.collisionRect(bullet2);
+                    intersect_rect = intersectRect(&rect1, &rect2);
+                    if(intersect_rect.w > 0 && intersect_rect.h > 0)
+                        contacts.push_back({CT_TWO_BULLETS, p, e, static_cast<int>(b1), static_cast<int>(b2)});
                 }
-                row.push_back(obj);
-            }
-            m_level.push_back(row);
+            return;
         }
+
+        k -= pairs_count;
+        int p = k / m_bonuses.size(), b = k % m_bonuses.size();
+        Player* pl = m_players.at(p);
+        Bonus* bonus = m_bonuses.at(b);
+        if(pl->to_erase || bonus->to_erase) return;
+        intersect_rect = intersectRect(&pl->collision_rect, &bonus->collision_rect);
+        if(intersect_rect.w > 0 && intersect_rect.h > 0)
+            contacts.push_back({CT_PLAYER_BONUS, p, b, 0, 0});
+    });
+
+    m_contacts.clear();
+    m_contacts.reserve(contacts_reserve);
+    for(auto& contacts : m_worker_contacts)
+        m_contacts.insert(m_contacts.end(), contacts.begin(), contacts.end());
+    std::sort(m_contacts.begin(), m_contacts.end());
+}
+
+void Game::resolveContacts()
+{
+    for(auto& c : m_contacts)
+    {
+        switch(c.type)
+        {
+        case CT_BULLET_LEVEL:
+            checkCollisionBulletWithLevel(bulletOf(tankAt(c.first), c.second));
+            break;
+        case CT_BULLET_BUSH:
+            checkCollisionBulletWithBush(bulletOf(m_players.at(c.first), c.second));
+            break;
+        case CT_PLAYER_BULLETS_ENEMY:
+            checkCollisionPlayerBulletsWithEnemy(m_players.at(c.first), m_enemies.at(c.second));
+            break;
+        case CT_TWO_BULLETS:
+            checkCollisionTwoBullets(bulletOf(m_players.at(c.first), c.third), bulletOf(m_enemies.at(c.second), c.fourth));
+            break;
+        case CT_ENEMY_BULLETS_PLAYER:
+            checkCollisionEnemyBulletsWithPlayer(m_enemies.at(c.first), m_players.at(c.second));
+            break;
+        case CT_PLAYER_BONUS:
+            checkCollisionPlayerWithBonus(m_players.at(c.first), m_bonuses.at(c.second));
+            break;
+        }
+    }
+}
+
+void Game::updateTankLimits(Uint32 dt)
+{
+    int tanks_count = m_enemies.size() + m_players.size();
+    //miejsce na największą możliwą liczbę czołgów, aby nowy przeciwnik nie powiększał kontenera
+    m_tank_limits.reserve(AppConfig::enemy_max_count_on_map + AppConfig::player_keys.size());
+    m_tank_limits.resize(tanks_count);
+    m_tank_motions.reserve(AppConfig::enemy_max_count_on_map + AppConfig::player_keys.size());
+    m_tank_motions.resize(tanks_count);
+    for(int k = 0; k < tanks_count; k++) m_tank_motions.at(k) = tankAt(k)->motion();
+
+    Engine::getEngine().getThreadPool()->parallelFor(tanks_count, [this, tanks_count, dt](int k, unsigned)
+    {
+        TankLimit& limit = m_tank_limits.at(k);
+        limit.distance = std::numeric_limits<double>::infinity();
+        limit.on_ice = false;
+
+        const Tank* tank = tankAt(k);
+        const Tank::Motion& motion = m_tank_motions.at(k);
+        for(int i = 0; i < tanks_count; i++)
+            if(i != k) checkCollisionTwoTanks(tank, motion, tankAt(i), m_tank_motions.at(i), limit);
+        checkCollisionTankWithLevel(tank, dt, limit);
+    });
+
+    for(int k = 0; k < tanks_count; k++)
+    {
+        Tank* tank = tankAt(k);
+        if(m_tank_limits.at(k).on_ice) tank->setFlag(TSF_ON_ICE);
+        tank->collide(m_tank_limits.at(k).distance);
     }
+}
 
-    m_level_rows_count = m_level.size();
-    if(m_level_rows_count)
-        m_level_columns_count = m_level.at(0).size();
-    else m_level_columns_count = 0;
+void Game::instantiateLevel(std::shared_ptr<const LevelTemplate> level_template)
+{
+    m_level_template = level_template;
+    m_level_rows_count = m_level_template->rows_count;
+    m_level_columns_count = m_level_template->columns_count;
+    m_map_rect = {0, 0, m_level_columns_count * AppConfig::tile_rect.w, m_level_rows_count * AppConfig::tile_rect.h};
+    m_level_rows.resize(m_level_rows_count);
+    m_level_copies.assign(m_level_rows_count, nullptr);
+    for(int j = 0; j < m_level_rows_count; j++) m_level_rows.at(j) = m_level_template->row(j);
+
+    for(auto bush : m_level_template->bushes)
+        m_bushes.push_back(m_level_arena.create<Object>(bush.x, bush.y, ST_BUSH));
 
     //tworzymy orzełka
-    m_eagle = new Eagle(12 * AppConfig::tile_rect.w, (m_level_rows_count - 2) * AppConfig::tile_rect.h);
+    m_eagle = m_level_arena.create<Eagle>(m_level_template->eagle.x, m_level_template->eagle.y);
+    m_player_fields.resize(2);
+    m_player_index.reset(m_map_rect, 4 * AppConfig::tile_rect.w);
+    m_player_index.reserve(m_player_fields.size());
+    m_players_indexed = false;
+    rebuildNavigation();
+}
 
-    //wyczyszczenie miejsca orzełeka
-    for(int i = 12; i < 14 && i < m_level_columns_count; i++)
+void Game::rebuildNavigation()
+{
+    m_eagle_field.build(m_level_rows, m_level_columns_count, FlowField::footprintAt(m_eagle->pos_x, m_eagle->pos_y));
+    for(auto& field : m_player_fields)
     {
-        for(int j = m_level_rows_count - 2; j < m_level_rows_count; j++)
+        field.clear(); //wyznaczane przy pierwszym użyciu
+        field.reserve(m_level_rows_count, m_level_columns_count);
+    }
+    m_line_of_sight.build(m_level_rows, m_level_columns_count);
+}
+
+void Game::updateNavigation(int row, int column)
+{
+    m_eagle_field.update(m_level_rows, m_level_columns_count, row, column);
+    for(auto& field : m_player_fields) field.update(m_level_rows, m_level_columns_count, row, column);
+    m_line_of_sight.update(m_level_rows, row, column);
+}
+
+void Game::runEnemyDecisions()
+{
+    //cel jest wybierany tylko przed zmianą kierunku jazdy; pomiędzy wyborami przeciwnik śledzi położenie wybranego celu
+    for(unsigned i = 0; i < m_enemies.size(); i++)
+    {
+        Enemy* enemy = m_enemies.at(i);
+        //wybrany gracz mógł zginąć i zniknąć ze zbioru graczy, a wtedy jego uchwyt przestaje być ważny
+        if(enemy->target_field == nullptr || (enemy->target_player != SlotMap<Player*>::null_handle && !m_players.contains(enemy->target_player))) assignTarget(enemy);
+        updateTargetPosition(enemy);
+        if(enemy->decisionPending()) m_ai_scheduler.add(i, decisionPriority(enemy));
+    }
+
+    ThreadPool* pool = Engine::getEngine().getThreadPool();
+    //bez pomiarów na wielu rdzeniach decyzje są domyślnie wyznaczane szeregowo
+    bool parallel = AppConfig::parallel_ai_decisions && pool->size() > 1;
+    unsigned threads_count = parallel ? pool->size() : 1;
+    m_ai_scheduler.run(AppConfig::ai_time_budget, threads_count * decisions_per_thread, [this, pool, parallel](const std::vector<unsigned>& batch)
+    {
+        //wybór celu może wyznaczyć pole odległości do gracza, więc odbywa się szeregowo przed wyznaczaniem decyzji
+        for(auto i : batch)
         {
-            if(m_level.at(j).at(i) != nullptr)
+            Enemy* enemy = m_enemies.at(i);
+            if(enemy->steeringPending())
             {
-                delete m_level.at(j).at(i);
-                m_level.at(j).at(i) = nullptr;
+                assignTarget(enemy);
+                updateTargetPosition(enemy);
             }
         }
+
+        //decyzje są wyznaczane bez zmiany stanu gry, a wykonywane szeregowo w ustalonej kolejności
+        m_enemy_intents.resize(batch.size());
+        auto plan = [this, &batch](int k, unsigned)
+        {
+            m_enemies.at(batch.at(k))->plan(m_enemy_intents.at(k));
+        };
+        //przy kilku decyzjach obudzenie wątków kosztuje więcej niż same decyzje
+        if(parallel && batch.size() >= parallel_decisions_min) pool->parallelFor(batch.size(), plan);
+        else for(unsigned k = 0; k < batch.size(); k++) plan(k, 0);
+        for(unsigned k = 0; k < batch.size(); k++) m_enemies.at(batch.at(k))->apply(m_enemy_intents.at(k));
+    });
+}
+
+int Game::decisionPriority(const Enemy* enemy)
+{
+    indexPlayers();
+    SDL_Point from = {enemy->dest_rect.x, enemy->dest_rect.y};
+    int distance = abs(m_eagle->dest_rect.x - from.x) + abs(m_eagle->dest_rect.y - from.y);
+    SlotMap<Player*>::Handle player;
+    int player_distance;
+    if(m_player_index.nearest(from, distance, player, player_distance)) distance = player_distance;
+    //każda milisekunda spóźnienia liczy się jak piksel odległości, więc odlegli przeciwnicy nie czekają bez końca
+    return distance - static_cast<int>(enemy->decisionDelay());
+}
+
+void Game::updateTargetPosition(Enemy* enemy)
+{
+    Player** player = m_players.get(enemy->target_player);
+    const SDL_Rect& target = player != nullptr ? (*player)->dest_rect : m_eagle->dest_rect;
+    enemy->target_position = {target.x + target.w / 2, target.y + target.h / 2};
+}
+
+void Game::indexPlayers()
+{
+    if(m_players_indexed) return;
+    m_player_index.clear();
+    for(unsigned i = 0; i < m_players.size(); i++)
+    {
+        const Player* player = m_players.at(i);
+        m_player_index.insert({player->dest_rect.x, player->dest_rect.y}, m_players.handleAt(i));
+    }
+    m_players_indexed = true;
+}
+
+void Game::assignTarget(Enemy* enemy)
+{
+    SlotMap<Player*>::Handle target = SlotMap<Player*>::null_handle;
+    const FlowField* field = &m_eagle_field;
+    if(enemy->type == ST_TANK_A || enemy->type == ST_TANK_D)
+    {
+        indexPlayers();
+        //gracz zostaje celem tylko wtedy, gdy jest bliżej niż orzełek
+        SDL_Point from = {enemy->dest_rect.x, enemy->dest_rect.y};
+        int eagle_metric = abs(m_eagle->dest_rect.x - from.x) + abs(m_eagle->dest_rect.y - from.y);
+        SlotMap<Player*>::Handle player;
+        int metric;
+        if(m_player_index.nearest(from, eagle_metric, player, metric))
+        {
+            target = player;
+            field = playerField(*m_players.get(player));
+        }
+    }
+    enemy->target_player = target;
+    enemy->target_field = field;
+}
+
+const FlowField* Game::playerField(const Player* player)
+{
+    FlowField& field = m_player_fields.at(player->type == ST_PLAYER_1 ? 0 : 1);
+    SDL_Point goal = FlowField::footprintAt(player->posX(), player->posY());
+    if(field.goal().x != goal.x || field.goal().y != goal.y) field.build(m_level_rows, m_level_columns_count, goal);
+    return &field;
+}
+
+void Game::reloadLevel()
+{
+    std::string path = AppConfig::levels_path + Engine::intToString(m_current_level);
+    LevelData data;
+    if(!LevelPack::readText(path, data))
+    {
+        std::cerr << "level " << path << " not reloaded: cannot read the file" << std::endl;
+        return;
+    }
+    if(data.rows_count != m_level_rows_count || data.columns_count != m_level_columns_count)
+    {
+        std::cerr << "level " << path << " not reloaded: map size changed, restart the level" << std::endl;
+        return;
+    }
+    std::shared_ptr<const LevelTemplate> level_template = std::make_shared<const LevelTemplate>(data);
+
+    //pola porównujemy z poprzednim wzorcem, a nie z mapą rozgrywki, aby nie odbudowywać uszkodzonych murków
+    for(int j = 0; j < m_level_rows_count; j++)
+    {
+        const Tile* old_row = m_level_template->row(j);
+        const Tile* new_row = level_template->row(j);
+        Tile* copy = m_level_copies.at(j);
+        if(copy == nullptr)
+        {
+            m_level_rows.at(j) = new_row; //wiersz niezmieniony w rozgrywce wskazuje wiersz nowego wzorca
+            continue;
+        }
+        for(int i = 0; i < m_level_columns_count; i++)
+            if(old_row[i].type != new_row[i].type) copy[i] = new_row[i];
+    }
+
+    //krzaki obu wzorców są ułożone wierszami, więc różnice można wyznaczyć jednym przejściem
+    const std::vector<SDL_Point>& old_bushes = m_level_template->bushes;
+    const std::vector<SDL_Point>& new_bushes = level_template->bushes;
+    auto before = [](const SDL_Point& a, const SDL_Point& b) { return a.y != b.y ? a.y < b.y : a.x < b.x; };
+    std::size_t o = 0, n = 0;
+    while(o < old_bushes.size() || n < new_bushes.size())
+    {
+        if(n == new_bushes.size() || (o < old_bushes.size() && before(old_bushes.at(o), new_bushes.at(n))))
+        {
+            const SDL_Point& removed = old_bushes.at(o++);
+            for(auto bush : m_bushes)
+                if(static_cast<int>(bush->pos_x) == removed.x && static_cast<int>(bush->pos_y) == removed.y) bush->to_erase = true;
+        }
+        else if(o == old_bushes.size() || before(new_bushes.at(n), old_bushes.at(o)))
+        {
+            const SDL_Point& added = new_bushes.at(n++);
+            m_bushes.push_back(m_level_arena.create<Object>(added.x, added.y, ST_BUSH));
+        }
+        else
+        {
+            o++;
+            n++;
+        }
     }
+    m_bushes.erase(std::remove_if(m_bushes.begin(), m_bushes.end(), [](Object*b){return b->to_erase;}), m_bushes.end());
+
+    m_level_template = level_template;
+    LevelTemplate::store(m_current_level, level_template);
+    m_level_revision++;
+    rebuildNavigation();
 }
 
 bool Game::finished() const
@@ -445,7 +806,10 @@ AppState* Game::nextState()
 {
     if(m_game_over || m_enemy_to_kill <= 0)
     {
-        m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [this](Player*p){m_killed_players.push_back(p); return true;}), m_players.end());
+        for(auto player : m_players) m_killed_players.push_back(player);
+        m_players.clear();
+        //magazyn pocisków kończy się razem z rozgrywką; gracze przechodzą do następnego poziomu bez pocisków
+        for(auto player : m_killed_players) player->releaseBullets();
         Scores* scores = new Scores(m_killed_players, m_current_level, m_game_over);
         return scores;
     }
@@ -464,56 +828,55 @@ void Game::clearLevel()
     for(auto bonus : m_bonuses) delete bonus;
     m_bonuses.clear();
 
-    for(auto row : m_level)
-    {
-        for(auto item : row) if(item != nullptr) delete item;
-        row.clear();
-    }
-    m_level.clear();
-
-    for(auto bush : m_bushes)  delete bush;
+    //krzaki i orzełek leżą w arenie poziomu i są zwalniane razem z nią
+    m_level_rows.clear();
+    m_level_copies.clear();
+    m_level_template.reset();
+    m_protect_eagle = false;
     m_bushes.clear();
-
-    if(m_eagle != nullptr) delete m_eagle;
     m_eagle = nullptr;
+    m_level_arena.reset();
 }
 
-void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
+void Game::checkCollisionTankWithLevel(const Tank* tank, Uint32 dt, TankLimit& limit) const
 {
     if(tank->to_erase) return;
 
     int row_start, row_end;
     int column_start, column_end;
 
-    SDL_Rect pr, *lr;
-    Object* o;
+    SDL_Rect pr, lr;
+    const SDL_Rect* cr = &tank->collision_rect;
+    Tank::Motion motion = tank->motion();
+    //zasięg ruchu w tej klatce; sprawdzamy tylko komórki, do których czołg może dojechać
+    int reach = motion.speed * dt + 1;
 
     //========================kolizja z elementami mapy========================
-    switch(tank->direction)
+    switch(motion.direction)
     {
     case D_UP:
-        row_end = tank->collision_rect.y / AppConfig::tile_rect.h;
-        row_start = row_end - 1;
-        column_start = tank->collision_rect.x / AppConfig::tile_rect.w - 1;
-        column_end = (tank->collision_rect.x + tank->collision_rect.w) / AppConfig::tile_rect.w + 1;
+        row_start = (cr->y - reach) / AppConfig::tile_rect.h;
+        row_end = cr->y / AppConfig::tile_rect.h;
+        column_start = cr->x / AppConfig::tile_rect.w;
+        column_end = (cr->x + cr->w - 1) / AppConfig::tile_rect.w;
         break;
     case D_RIGHT:
-        column_start = (tank->collision_rect.x + tank->collision_rect.w) / AppConfig::tile_rect.w;
-        column_end = column_start + 1;
-        row_start = tank->collision_rect.y / AppConfig::tile_rect.h - 1;
-        row_end = (tank->collision_rect.y + tank->collision_rect.h) / AppConfig::tile_rect.h + 1;
+        column_start = (cr->x + cr->w - 1) / AppConfig::tile_rect.w;
+        column_end = (cr->x + cr->w + reach) / AppConfig::tile_rect.w;
+        row_start = cr->y / AppConfig::tile_rect.h;
+        row_end = (cr->y + cr->h - 1) / AppConfig::tile_rect.h;
         break;
     case D_DOWN:
-        row_start = (tank->collision_rect.y + tank->collision_rect.h)/ AppConfig::tile_rect.h;
-        row_end = row_start + 1;
-        column_start = tank->collision_rect.x / AppConfig::tile_rect.w - 1;
-        column_end = (tank->collision_rect.x + tank->collision_rect.w) / AppConfig::tile_rect.w + 1;
+        row_start = (cr->y + cr->h - 1) / AppConfig::tile_rect.h;
+        row_end = (cr->y + cr->h + reach) / AppConfig::tile_rect.h;
+        column_start = cr->x / AppConfig::tile_rect.w;
+        column_end = (cr->x + cr->w - 1) / AppConfig::tile_rect.w;
         break;
     case D_LEFT:
-        column_end = tank->collision_rect.x / AppConfig::tile_rect.w;
-        column_start = column_end - 1;
-        row_start = tank->collision_rect.y / AppConfig::tile_rect.h - 1;
-        row_end = (tank->collision_rect.y + tank->collision_rect.h) / AppConfig::tile_rect.h + 1;
+        column_start = (cr->x - reach) / AppConfig::tile_rect.w;
+        column_end = cr->x / AppConfig::tile_rect.w;
+        row_start = cr->y / AppConfig::tile_rect.h;
+        row_end = (cr->y + cr->h - 1) / AppConfig::tile_rect.h;
         break;
     }
     if(column_start < 0) column_start = 0;
@@ -524,30 +887,22 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     pr = tank->nextCollisionRect(dt);
     SDL_Rect intersect_rect;
 
-
     for(int i = row_start; i <= row_end; i++)
-        for(int j = column_start; j <= column_end ;j++)
+        for(int j = column_start; j <= column_end; j++)
         {
-            if(tank->stop) break;
-            o = m_level.at(i).at(j);
-            if(o == nullptr) continue;
-            if(tank->testFlag(TSF_BOAT) && o->type == ST_WATER) continue;
+            const Tile& tile = tileAt(i, j);
+            if(tile.empty()) continue;
+            if(tank->testFlag(TSF_BOAT) && tile.type == ST_WATER) continue;
 
-            lr = &o->collision_rect;
-
-            intersect_rect = intersectRect(lr, &pr);
-            if(intersect_rect.w > 0 && intersect_rect.h > 0)
+            lr = tile.collisionRect(i, j);
+            if(tile.type == ST_ICE)
             {
-                if(o->type == ST_ICE)
-                {
-                    if(intersect_rect.w > 10 && intersect_rect.h > 10)
-                       tank->setFlag(TSF_ON_ICE);
-                    continue;
-                }
-                else
-                    tank->collide(intersect_rect);
-                break;
+                intersect_rect = intersectRect(&lr, &pr);
+                if(intersect_rect.w > 10 && intersect_rect.h > 10)
+                   limit.on_ice = true;
+                continue;
             }
+            limit.distance = std::min(limit.distance, tank->distanceTo(lr, motion));
         }
 
     //========================kolizja z granicami mapy========================
@@ -556,92 +911,84 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     outside_map_rect.x = -AppConfig::tile_rect.w;
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
-    intersect_rect = intersectRect(&outside_map_rect, &pr);
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-        tank->collide(intersect_rect);
+    outside_map_rect.h = m_map_rect.h + 2 * AppConfig::tile_rect.h;
+    limit.distance = std::min(limit.distance, tank->distanceTo(outside_map_rect, motion));
 
     //prostokąt po prawej stronie mapy
-    outside_map_rect.x = AppConfig::map_rect.w;
+    outside_map_rect.x = m_map_rect.w;
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
-    intersect_rect = intersectRect(&outside_map_rect, &pr);
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-        tank->collide(intersect_rect);
+    outside_map_rect.h = m_map_rect.h + 2 * AppConfig::tile_rect.h;
+    limit.distance = std::min(limit.distance, tank->distanceTo(outside_map_rect, motion));
 
     //prostokąt po górnej stronie mapy
     outside_map_rect.x = 0;
     outside_map_rect.y = -AppConfig::tile_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.w = m_map_rect.w;
     outside_map_rect.h = AppConfig::tile_rect.h;
-    intersect_rect = intersectRect(&outside_map_rect, &pr);
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-        tank->collide(intersect_rect);
+    limit.distance = std::min(limit.distance, tank->distanceTo(outside_map_rect, motion));
 
     //prostokąt po dolnej stronie mapy
     outside_map_rect.x = 0;
-    outside_map_rect.y = AppConfig::map_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.y = m_map_rect.h;
+    outside_map_rect.w = m_map_rect.w;
     outside_map_rect.h = AppConfig::tile_rect.h;
-    intersect_rect = intersectRect(&outside_map_rect, &pr);
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-        tank->collide(intersect_rect);
-
+    limit.distance = std::min(limit.distance, tank->distanceTo(outside_map_rect, motion));
 
    //========================kolizja z orzełkiem========================
-    intersect_rect = intersectRect(&m_eagle->collision_rect, &pr);
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-        tank->collide(intersect_rect);
+    limit.distance = std::min(limit.distance, tank->distanceTo(m_eagle->collision_rect, motion));
 }
 
-void Game::checkCollisionTwoTanks(Tank* tank1, Tank* tank2, Uint32 dt)
+void Game::checkCollisionTwoTanks(const Tank* tank1, const Tank::Motion& motion1, const Tank* tank2, const Tank::Motion& motion2, TankLimit& limit) const
 {
-    SDL_Rect cr1 = tank1->nextCollisionRect(dt);
-    SDL_Rect cr2 = tank2->nextCollisionRect(dt);
-    SDL_Rect intersect_rect = intersectRect(&cr1, &cr2);
+    double distance = tank1->distanceTo(tank2->collision_rect, motion1);
+    if(!std::isfinite(distance)) return;
 
-    if(intersect_rect.w > 0 && intersect_rect.h > 0)
-    {
-        tank1->collide(intersect_rect);
-        tank2->collide(intersect_rect);
-    }
+    //czołgi jadące na siebie dzielą wolną przestrzeń po połowie
+    bool moving1 = motion1.speed > 0 && !(motion1.flags & TSF_FROZEN);
+    bool moving2 = motion2.speed > 0 && !(motion2.flags & TSF_FROZEN);
+    if(moving1 && moving2 && std::isfinite(tank2->distanceTo(tank1->collision_rect, motion2)))
+        distance /= 2;
+
+    limit.distance = std::min(limit.distance, distance);
 }
 
-void Game::checkCollisionBulletWithLevel(Bullet* bullet)
+void Game::checkCollisionBulletWithLevel(int bullet)
 {
-    if(bullet == nullptr) return;
-    if(bullet->collide) return;
+    if(bullet < 0) return;
+    if(m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE)) return;
 
     int row_start, row_end;
     int column_start, column_end;
 
-    SDL_Rect* br, *lr;
+    SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+    Direction direction = m_bullets.direction(bullet);
+    SDL_Rect* br;
+    SDL_Rect lr;
     SDL_Rect intersect_rect;
-    Object* o;
 
     //========================kolizja z elementami mapy========================
-    switch(bullet->direction)
+    switch(direction)
     {
     case D_UP:
-        row_start = row_end = bullet->collision_rect.y / AppConfig::tile_rect.h;
-        column_start = bullet->collision_rect.x / AppConfig::tile_rect.w;
-        column_end = (bullet->collision_rect.x + bullet->collision_rect.w) / AppConfig::tile_rect.w;
+        row_start = row_end = bullet_rect.y / AppConfig::tile_rect.h;
+        column_start = bullet_rect.x / AppConfig::tile_rect.w;
+        column_end = (bullet_rect.x + bullet_rect.w) / AppConfig::tile_rect.w;
         break;
     case D_RIGHT:
-        column_start = column_end = (bullet->collision_rect.x + bullet->collision_rect.w) / AppConfig::tile_rect.w;
-        row_start = bullet->collision_rect.y / AppConfig::tile_rect.h;
-        row_end = (bullet->collision_rect.y + bullet->collision_rect.h) / AppConfig::tile_rect.h;
+        column_start = column_end = (bullet_rect.x + bullet_rect.w) / AppConfig::tile_rect.w;
+        row_start = bullet_rect.y / AppConfig::tile_rect.h;
+        row_end = (bullet_rect.y + bullet_rect.h) / AppConfig::tile_rect.h;
         break;
     case D_DOWN:
-        row_start = row_end = (bullet->collision_rect.y + bullet->collision_rect.h)/ AppConfig::tile_rect.h;
-        column_start = bullet->collision_rect.x / AppConfig::tile_rect.w;
-        column_end = (bullet->collision_rect.x + bullet->collision_rect.w) / AppConfig::tile_rect.w;
+        row_start = row_end = (bullet_rect.y + bullet_rect.h)/ AppConfig::tile_rect.h;
+        column_start = bullet_rect.x / AppConfig::tile_rect.w;
+        column_end = (bullet_rect.x + bullet_rect.w) / AppConfig::tile_rect.w;
         break;
     case D_LEFT:
-        column_start = column_end = bullet->collision_rect.x / AppConfig::tile_rect.w;
-        row_start = bullet->collision_rect.y / AppConfig::tile_rect.h;
-        row_end = (bullet->collision_rect.y + bullet->collision_rect.h) / AppConfig::tile_rect.h;
+        column_start = column_end = bullet_rect.x / AppConfig::tile_rect.w;
+        row_start = bullet_rect.y / AppConfig::tile_rect.h;
+        row_end = (bullet_rect.y + bullet_rect.h) / AppConfig::tile_rect.h;
         break;
     }
     if(column_start < 0) column_start = 0;
@@ -649,43 +996,35 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
     if(column_end >= m_level_columns_count) column_end = m_level_columns_count - 1;
     if(row_end >= m_level_rows_count) row_end = m_level_rows_count - 1;
 
-    br = &bullet->collision_rect;
+    br = &bullet_rect;
 
     for(int i = row_start; i <= row_end; i++)
         for(int j = column_start; j <= column_end; j++)
         {
-            o = m_level.at(i).at(j);
-            if(o == nullptr) continue;
-            if(o->type == ST_ICE || o->type == ST_WATER) continue;
+            const Tile& tile = tileAt(i, j);
+            if(tile.empty()) continue;
+            if(tile.type == ST_ICE || tile.type == ST_WATER) continue;
 
-            lr = &o->collision_rect;
-            intersect_rect = intersectRect(lr, br);
+            lr = tile.collisionRect(i, j);
+            intersect_rect = intersectRect(&lr, br);
 
             if(intersect_rect.w > 0 && intersect_rect.h > 0)
             {
-                if(bullet->increased_damage)
-                {
-                    delete o;
-                    m_level.at(i).at(j) = nullptr;
-                }
-                else if(o->type == ST_BRICK_WALL)
-                {
-                    Brick* brick = dynamic_cast<Brick*>(o);
-                    brick->bulletHit(bullet->direction);
-                    if(brick->to_erase)
-                    {
-                        delete brick;
-                        m_level.at(i).at(j) = nullptr;
-                    }
-                }
-                bullet->destroy();
+                m_level_revision++;
+                Tile& hit_tile = editTile(i, j);
+                if(m_bullets.testFlag(bullet, BulletStore::BF_INCREASED_DAMAGE))
+                    hit_tile = Tile();
+                else if(hit_tile.type == ST_BRICK_WALL)
+                    hit_tile.bulletHit(direction);
+                if(hit_tile.empty()) updateNavigation(i, j);
+                m_bullets.destroy(bullet);
             }
         }
 
     //========================kolizja z granicami mapy========================
-    if(br->x < 0 || br->y < 0 || br->x + br->w > AppConfig::map_rect.w || br->y + br->h > AppConfig::map_rect.h)
+    if(br->x < 0 || br->y < 0 || br->x + br->w > m_map_rect.w || br->y + br->h > m_map_rect.h)
     {
-        bullet->destroy();
+        m_bullets.destroy(bullet);
     }
     //========================kolizja z orzełkiem========================
     if(m_eagle->type == ST_EAGLE && !m_game_over)
@@ -693,7 +1032,7 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
         intersect_rect = intersectRect(&m_eagle->collision_rect, br);
         if(intersect_rect.w > 0 && intersect_rect.h > 0)
         {
-            bullet->destroy();
+            m_bullets.destroy(bullet);
             m_eagle->destroy();
             m_game_over_position = AppConfig::map_rect.h;
             m_game_over = true;
@@ -701,15 +1040,182 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
     }
 }
 
-void Game::checkCollisionBulletWithBush(Bullet *bullet)
+void Game::predictBulletImpact(int bullet)
 {
-    if(bullet == nullptr) return;
-    if(bullet->collide) return;
-    if(!bullet->increased_damage) return;
+    SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+    Direction direction = m_bullets.direction(bullet);
+    SDL_Rect* br = &bullet_rect;
+    SDL_Rect* lr;
+    int impact_position = 0;
+    SDL_Rect tile_rect;
+    bool found;
+
+    int row_start = std::max(br->y / AppConfig::tile_rect.h, 0);
+    int row_end = std::min((br->y + br->h - 1) / AppConfig::tile_rect.h, m_level_rows_count - 1);
+    int column_start = std::max(br->x / AppConfig::tile_rect.w, 0);
+    int column_end = std::min((br->x + br->w - 1) / AppConfig::tile_rect.w, m_level_columns_count - 1);
+
+    //przeszkody są przeszukiwane wiersz po wierszu (lub kolumna po kolumnie) w kierunku lotu aż do pierwszej trafionej
+    switch(direction)
+    {
+    case D_UP:
+        impact_position = 0;
+        found = false;
+        for(int i = row_end; i >= 0 && !found; i--)
+            for(int j = column_start; j <= column_end; j++)
+            {
+                const Tile& tile = tileAt(i, j);
+                if(tile.empty() || tile.type == ST_ICE || tile.type == ST_WATER) continue;
+                tile_rect = tile.collisionRect(i, j);
+                lr = &tile_rect;
+                if(lr->w <= 0 || lr->h <= 0 || lr->x >= br->x + br->w || lr->x + lr->w <= br->x) continue;
+                if(lr->y < br->y + br->h && lr->y + lr->h > impact_position)
+                {
+                    impact_position = lr->y + lr->h;
+                    found = true;
+                }
+            }
+        break;
+    case D_DOWN:
+        impact_position = m_map_rect.h;
+        found = false;
+        for(int i = row_start; i < m_level_rows_count && !found; i++)
+            for(int j = column_start; j <= column_end; j++)
+            {
+                const Tile& tile = tileAt(i, j);
+                if(tile.empty() || tile.type == ST_ICE || tile.type == ST_WATER) continue;
+                tile_rect = tile.collisionRect(i, j);
+                lr = &tile_rect;
+                if(lr->w <= 0 || lr->h <= 0 || lr->x >= br->x + br->w || lr->x + lr->w <= br->x) continue;
+                if(lr->y + lr->h > br->y && lr->y < impact_position)
+                {
+                    impact_position = lr->y;
+                    found = true;
+                }
+            }
+        break;
+    case D_LEFT:
+        impact_position = 0;
+        found = false;
+        for(int j = column_end; j >= 0 && !found; j--)
+            for(int i = row_start; i <= row_end; i++)
+            {
+                const Tile& tile = tileAt(i, j);
+                if(tile.empty() || tile.type == ST_ICE || tile.type == ST_WATER) continue;
+                tile_rect = tile.collisionRect(i, j);
+                lr = &tile_rect;
+                if(lr->w <= 0 || lr->h <= 0 || lr->y >= br->y + br->h || lr->y + lr->h <= br->y) continue;
+                if(lr->x < br->x + br->w && lr->x + lr->w > impact_position)
+                {
+                    impact_position = lr->x + lr->w;
+                    found = true;
+                }
+            }
+        break;
+    case D_RIGHT:
+        impact_position = m_map_rect.w;
+        found = false;
+        for(int j = column_start; j < m_level_columns_count && !found; j++)
+            for(int i = row_start; i <= row_end; i++)
+            {
+                const Tile& tile = tileAt(i, j);
+                if(tile.empty() || tile.type == ST_ICE || tile.type == ST_WATER) continue;
+                tile_rect = tile.collisionRect(i, j);
+                lr = &tile_rect;
+                if(lr->w <= 0 || lr->h <= 0 || lr->y >= br->y + br->h || lr->y + lr->h <= br->y) continue;
+                if(lr->x + lr->w > br->x && lr->x < impact_position)
+                {
+                    impact_position = lr->x;
+                    found = true;
+                }
+            }
+        break;
+    }
+
+    //orzełek
+    if(m_eagle->type == ST_EAGLE && !m_game_over)
+    {
+        lr = &m_eagle->collision_rect;
+        switch(direction)
+        {
+        case D_UP:
+            if(lr->x < br->x + br->w && br->x < lr->x + lr->w && lr->y < br->y + br->h)
+                impact_position = std::max(impact_position, lr->y + lr->h);
+            break;
+        case D_DOWN:
+            if(lr->x < br->x + br->w && br->x < lr->x + lr->w && lr->y + lr->h > br->y)
+                impact_position = std::min(impact_position, lr->y);
+            break;
+        case D_LEFT:
+            if(lr->y < br->y + br->h && br->y < lr->y + lr->h && lr->x < br->x + br->w)
+                impact_position = std::max(impact_position, lr->x + lr->w);
+            break;
+        case D_RIGHT:
+            if(lr->y < br->y + br->h && br->y < lr->y + lr->h && lr->x + lr->w > br->x)
+                impact_position = std::min(impact_position, lr->x);
+            break;
+        }
+    }
+
+    m_bullets.setImpact(bullet, impact_position, m_level_revision);
+}
+
+bool Game::bulletImpactDue(int bullet) const
+{
+    SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+    const SDL_Rect* br = &bullet_rect;
+    int impact_position = m_bullets.impactPosition(bullet);
+    if(br->x < 0 || br->y < 0 || br->x + br->w > m_map_rect.w || br->y + br->h > m_map_rect.h)
+        return true;
+
+    switch(m_bullets.direction(bullet))
+    {
+    case D_UP:
+        return br->y < impact_position;
+    case D_RIGHT:
+        return br->x + br->w > impact_position;
+    case D_DOWN:
+        return br->y + br->h > impact_position;
+    case D_LEFT:
+        return br->x < impact_position;
+    }
+    return true;
+}
+
+bool Game::detectCollisionBulletWithLevel(int bullet)
+{
+    if(bullet < 0 || m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE)) return false;
+
+    //pocisk leci po linii prostej, więc sprawdzamy go dopiero gdy dotrze do przewidzianej przeszkody
+    if(m_bullets.impactRevision(bullet) != m_level_revision) predictBulletImpact(bullet);
+    return bulletImpactDue(bullet);
+}
+
+bool Game::detectCollisionBulletWithBush(int bullet) const
+{
+    if(bullet < 0 || m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE) || !m_bullets.testFlag(bullet, BulletStore::BF_INCREASED_DAMAGE)) return false;
+
+    SDL_Rect intersect_rect;
+    SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+    for(auto bush : m_bushes)
+    {
+        if(bush->to_erase) continue;
+        intersect_rect = intersectRect(&bush->collision_rect, &bullet_rect);
+        if(intersect_rect.w > 0 && intersect_rect.h > 0) return true;
+    }
+    return false;
+}
+
+void Game::checkCollisionBulletWithBush(int bullet)
+{
+    if(bullet < 0) return;
+    if(m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE)) return;
+    if(!m_bullets.testFlag(bullet, BulletStore::BF_INCREASED_DAMAGE)) return;
 
     SDL_Rect* br, *lr;
     SDL_Rect intersect_rect;
-    br = &bullet->collision_rect;
+    SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+    br = &bullet_rect;
 
     for(auto bush : m_bushes)
     {
@@ -719,7 +1225,7 @@ void Game::checkCollisionBulletWithBush(Bullet *bullet)
 
         if(intersect_rect.w > 0 && intersect_rect.h > 0)
         {
-            bullet->destroy();
+            m_bullets.destroy(bullet);
             bush->to_erase = true;
         }
     }
@@ -731,16 +1237,18 @@ void Game::checkCollisionPlayerBulletsWithEnemy(Player *player, Enemy *enemy)
     if(enemy->testFlag(TSF_DESTROYED)) return;
     SDL_Rect intersect_rect;
 
-    for(auto bullet : player->bullets)
+    for(unsigned b = 0; b < player->bullets.size(); b++)
     {
-        if(!bullet->to_erase && !bullet->collide)
+        int bullet = bulletOf(player, b);
+        if(bullet >= 0 && !m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE))
         {
-            intersect_rect = intersectRect(&bullet->collision_rect, &enemy->collision_rect);
+            SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+            intersect_rect = intersectRect(&bullet_rect, &enemy->collision_rect);
             if(intersect_rect.w > 0 && intersect_rect.h > 0)
             {
                 if(enemy->testFlag(TSF_BONUS)) generateBonus();
 
-                bullet->destroy();
+                m_bullets.destroy(bullet);
                 enemy->destroy();
                 if(enemy->lives_count <= 0) m_enemy_to_kill--;
                 player->score += enemy->scoreForHit();
@@ -755,34 +1263,49 @@ void Game::checkCollisionEnemyBulletsWithPlayer(Enemy *enemy, Player *player)
     if(player->testFlag(TSF_DESTROYED)) return;
     SDL_Rect intersect_rect;
 
-    for(auto bullet : enemy->bullets)
+    for(unsigned b = 0; b < enemy->bullets.size(); b++)
     {
-        if(!bullet->to_erase && !bullet->collide)
+        int bullet = bulletOf(enemy, b);
+        if(bullet >= 0 && !m_bullets.testFlag(bullet, BulletStore::BF_COLLIDE))
         {
-            intersect_rect = intersectRect(&bullet->collision_rect, &player->collision_rect);
+            SDL_Rect bullet_rect = m_bullets.collisionRect(bullet);
+            intersect_rect = intersectRect(&bullet_rect, &player->collision_rect);
             if(intersect_rect.w > 0 && intersect_rect.h > 0)
             {
-                bullet->destroy();
+                m_bullets.destroy(bullet);
                 player->destroy();
             }
         }
     }
 }
 
-void Game::checkCollisionTwoBullets(Bullet *bullet1, Bullet *bullet2)
+void Game::checkCollisionTwoBullets(int bullet1, int bullet2)
 {
-    if(bullet1 == nullptr || bullet2 == nullptr) return;
-    if(bullet1->to_erase || bullet2->to_erase) return;
+    if(bullet1 < 0 || bullet2 < 0) return;
 
-    SDL_Rect intersect_rect = intersectRect(&bullet1->collision_rect, &bullet2->collision_rect);
+    SDL_Rect rect1 = m_bullets.collisionRect(bullet1), rect2 = m_bullets.collisionRect(bullet2);
+    SDL_Rect intersect_rect = intersectRect(&rect1, &rect2);
 
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
     {
-        bullet1->destroy();
-        bullet2->destroy();
+        m_bullets.destroy(bullet1);
+        m_bullets.destroy(bullet2);
     }
 }
 
+int Game::bulletOf(const Tank* tank, unsigned number) const
+{
+    return m_bullets.indexOf(tank->bullets.at(number));
+}
+
+void Game::reserveBullets()
+{
+    unsigned count = 0;
+    for(auto enemy : m_enemies) count += enemy->bulletCapacity();
+    for(auto player : m_players) count += player->bulletCapacity();
+    m_bullets.reserve(count);
+}
+
 void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
 {
     if(player->to_erase || bonus->to_erase) return;
@@ -814,24 +1337,9 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
         }
         else if(bonus->type == ST_BONUS_SHOVEL)
         {
+            buildEagleWall();
             m_protect_eagle = true;
             m_protect_eagle_time = 0;
-            for(int i = 0; i < 3; i++)
-            {
-                if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(11);
-                m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
-
-                if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(14);
-                m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
-            for(int i = 12; i < 14; i++)
-            {
-                if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                    delete m_level.at(m_level_rows_count - 3).at(i);
-                m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
         }
         else if(bonus->type == ST_BONUS_TANK)
         {
@@ -840,10 +1348,12 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
         else if(bonus->type == ST_BONUS_STAR)
         {
             player->changeStarCountBy(1);
+            reserveBullets();
         }
         else if(bonus->type == ST_BONUS_GUN)
         {
             player->changeStarCountBy(3);
+            reserveBullets();
         }
         else if(bonus->type == ST_BONUS_BOAT)
         {
@@ -853,49 +1363,146 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
     }
 }
 
+int Game::levelAfter(int level)
+{
+    level++;
+    if(level > 35) level = 1;
+    if(level < 0) level = 35;
+    return level;
+}
+
 void Game::nextLevel()
 {
-    m_current_level++;
-    if(m_current_level > 35) m_current_level = 1;
-    if(m_current_level < 0) m_current_level = 35;
+    m_current_level = levelAfter(m_current_level);
+    if(AppConfig::generated_levels)
+    {
+        //poziom losowy powstaje w pamięci, bez plików poziomów
+        LevelData data;
+        LevelGenerator::generate(LevelGenerator::levelSeed(AppConfig::generator_seed, m_current_level), data);
+        startLevel(std::make_shared<const LevelTemplate>(data));
+        return;
+    }
+    startLevel(LevelTemplate::get(m_current_level));
+    if(AppConfig::level_hot_reload) m_level_watcher.watch(AppConfig::levels_path + Engine::intToString(m_current_level));
+}
 
+void Game::startLevel(std::shared_ptr<const LevelTemplate> level_template)
+{
     m_level_start_screen = true;
     m_level_start_time = 0;
+    m_level_time = 0;
     m_game_over = false;
     m_finished = false;
-    m_enemy_to_kill = AppConfig::enemy_start_count;
-
-    std::string level_path = AppConfig::levels_path + Engine::intToString(m_current_level);
-    loadLevel(level_path);
+    instantiateLevel(level_template);
+    m_enemy_to_kill = m_level_template->roster.empty() ? AppConfig::enemy_start_count : m_level_template->roster.size();
+    m_roster_spawned = 0;
 
     if(m_players.empty())
     {
         if(m_player_count == 2)
         {
-            Player* p1 = new Player(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1);
-            Player* p2 = new Player(AppConfig::player_starting_point.at(1).x, AppConfig::player_starting_point.at(1).y, ST_PLAYER_2);
+            SDL_Point start1 = playerStart(0), start2 = playerStart(1);
+            Player* p1 = new Player(&m_tanks, start1.x, start1.y, ST_PLAYER_1);
+            Player* p2 = new Player(&m_tanks, start2.x, start2.y, ST_PLAYER_2);
             p1->player_keys = AppConfig::player_keys.at(0);
             p2->player_keys = AppConfig::player_keys.at(1);
-            m_players.push_back(p1);
-            m_players.push_back(p2);
+            m_players.insert(p1);
+            m_players.insert(p2);
 
         }
         else
         {
-            Player* p1 = new Player(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1);
+            SDL_Point start1 = playerStart(0);
+            Player* p1 = new Player(&m_tanks, start1.x, start1.y, ST_PLAYER_1);
             p1->player_keys = AppConfig::player_keys.at(0);
-            m_players.push_back(p1);
+            m_players.insert(p1);
         }
     }
+    else
+    {
+        for(auto player : m_players) player->starting_point = playerStart(player->type == ST_PLAYER_1 ? 0 : 1);
+    }
+    for(auto player : m_players) player->bullet_store = &m_bullets;
+    reserveBullets();
+}
+
+SDL_Point Game::playerStart(unsigned index) const
+{
+    const std::vector<SDL_Point>& starts = m_level_template->player_starts;
+    return starts.at(std::min<std::size_t>(index, starts.size() - 1));
+}
+
+void Game::buildEagleWall()
+{
+    for(auto& cell : m_level_template->eagle_wall)
+    {
+        if(!m_protect_eagle || tileAt(cell.y, cell.x).empty()) editTile(cell.y, cell.x) = Tile(ST_STONE_WALL);
+    }
+    m_level_revision++;
+    rebuildNavigation();
+}
+
+void Game::removeEagleWall()
+{
+    for(auto& cell : m_level_template->eagle_wall)
+    {
+        editTile(cell.y, cell.x) = Tile(ST_BRICK_WALL);
+    }
+    m_protect_eagle = false;
+    m_protect_eagle_time = 0;
+    m_level_revision++;
+    rebuildNavigation();
+}
+
+const Tile& Game::tileAt(int row, int column) const
+{
+    return m_level_rows.at(row)[column];
+}
+
+Tile& Game::editTile(int row, int column)
+{
+    Tile*& copy = m_level_copies.at(row);
+    if(copy == nullptr)
+    {
+        //pierwsza zmiana w wierszu - kopiujemy wiersz wzorca do pamięci poziomu
+        copy = static_cast<Tile*>(m_level_arena.allocate(m_level_columns_count * sizeof(Tile), alignof(Tile)));
+        std::copy(m_level_rows.at(row), m_level_rows.at(row) + m_level_columns_count, copy);
+        m_level_rows.at(row) = copy;
+    }
+    return copy[column];
 }
 
 void Game::generateEnemy()
 {
+    const std::vector<LevelTemplate::RosterEntry>& roster = m_level_template->roster;
+    if(!roster.empty() && m_roster_spawned >= roster.size()) return;
+
+    const std::vector<SDL_Point>& spawns = m_level_template->enemy_spawns;
+    if(m_enemy_respown_position >= spawns.size()) m_enemy_respown_position = 0;
+    const SDL_Point& spawn = spawns.at(m_enemy_respown_position);
+    m_enemy_respown_position++;
+    m_spawned_count++;
+    m_ai_scheduler.reserve(m_enemies.size() + 1);
+    m_enemy_intents.reserve(m_enemies.size() + 1);
+    m_tanks.reserve(m_enemies.size() + m_players.size() + 1);
+
+    if(!roster.empty())
+    {
+        //wrogowie pojawiają się w kolejności z pliku poziomu, niezależnie od tego, ilu z nich już zginęło
+        const LevelTemplate::RosterEntry& entry = roster.at(m_roster_spawned++);
+        Enemy* e = new Enemy(&m_tanks, spawn.x, spawn.y, entry.type);
+        e->lives_count = entry.lives_count;
+        if(entry.bonus) e->setFlag(TSF_BONUS);
+        e->line_of_sight = &m_line_of_sight;
+        e->bullet_store = &m_bullets;
+        m_enemies.insert(e);
+        reserveBullets();
+        return;
+    }
+
     float p = static_cast<float>(rand()) / RAND_MAX;
     SpriteType type = static_cast<SpriteType>(p < (0.00735 * m_current_level + 0.09265) ? ST_TANK_D : rand() % (ST_TANK_C - ST_TANK_A + 1) + ST_TANK_A);
-    Enemy* e = new Enemy(AppConfig::enemy_starting_point.at(m_enemy_respown_position).x, AppConfig::enemy_starting_point.at(m_enemy_respown_position).y, type);
-    m_enemy_respown_position++;
-    if(m_enemy_respown_position >= AppConfig::enemy_starting_point.size()) m_enemy_respown_position = 0;
+    Enemy* e = new Enemy(&m_tanks, spawn.x, spawn.y, type);
 
     double a, b, c;
     if(m_current_level <= 17)
@@ -920,20 +1527,24 @@ void Game::generateEnemy()
     p = static_cast<float>(rand()) / RAND_MAX;
     if(p < 0.12) e->setFlag(TSF_BONUS);
 
-    m_enemies.push_back(e);
+    e->line_of_sight = &m_line_of_sight;
+    e->bullet_store = &m_bullets;
+    m_enemies.insert(e);
+    reserveBullets();
 }
 
 void Game::generateBonus()
 {
     Bonus* b = new Bonus(0, 0, static_cast<SpriteType>(rand() % (ST_BONUS_BOAT - ST_BONUS_GRENADE + 1) + ST_BONUS_GRENADE));
+    m_spawned_count++;
     SDL_Rect intersect_rect;
     do
     {
-        b->pos_x = rand() % (AppConfig::map_rect.x + AppConfig::map_rect.w - 1 *  AppConfig::tile_rect.w);
-        b->pos_y = rand() % (AppConfig::map_rect.y + AppConfig::map_rect.h - 1 * AppConfig::tile_rect.h);
+        b->pos_x = rand() % (m_map_rect.x + m_map_rect.w - 1 *  AppConfig::tile_rect.w);
+        b->pos_y = rand() % (m_map_rect.y + m_map_rect.h - 1 * AppConfig::tile_rect.h);
         b->update(0);
         intersect_rect = intersectRect(&b->collision_rect, &m_eagle->collision_rect);
     }while(intersect_rect.w > 0 && intersect_rect.h > 0);
 
-    m_bonuses.push_back(b);
+    m_bonuses.insert(b);
 }
@@ -4,10 +4,17 @@
 #include "../objects/object.h"
 #include "../objects/player.h"
 #include "../objects/enemy.h"
-#include "../objects/bullet.h"
-#include "../objects/brick.h"
+#include "../objects/bulletstore.h"
+#include "../objects/tile.h"
+#include "../objects/leveltemplate.h"
 #include "../objects/eagle.h"
 #include "../objects/bonus.h"
+#include "../objects/flowfield.h"
+#include "../objects/lineofsight.h"
+#include "../engine/aischeduler.h"
+#include "../engine/arena.h"
+#include "../engine/filewatcher.h"
+#include "../engine/spatialgrid.h"
 #include <vector>
 #include <string>
 
@@ -27,6 +34,14 @@ public:
      * @param players_count - liczba graczy 1 lub 2
      */
     Game(int players_count);
+    /**
+     * Konstruktor rozpoczynający rozgrywkę na poziomie przekazanym w pamięci, np. utworzonym przez @a LevelGenerator, bez sięgania do plików poziomów.
+     * Po zakończeniu rundy gra przechodzi do poziomu następującego po podanym numerze.
+     * @param players_count - liczba graczy 1 lub 2
+     * @param level_template - wzorzec poziomu
+     * @param level - numer rundy, od którego zależą wyświetlany numer i siła wrogów
+     */
+    Game(int players_count, std::shared_ptr<const LevelTemplate> level_template, int level);
     /**
      * Konstruktor przyjmujący już isteniejących graczy.
      * Wywoływany w @a Score::nextState
@@ -68,22 +83,150 @@ public:
      * @return wskaźnik na obiekty klasy @a Scores jeżeli gracz przeszedł rundę lub przegrał. Jeżeli gracz wcisną Esc funkcja zwraca wskaźnik na obiekt @a Menu.
      */
     AppState* nextState();
+    /**
+     * @param level - numer rundy
+     * @return numer rundy następującej po podanej; po ostatniej rundzie gra wraca do pierwszej
+     */
+    static int levelAfter(int level);
+
+    /**
+     * @brief Łączny czas faz aktualizacji rundy w taktach SDL_GetPerformanceCounter, zliczany od utworzenia gry lub od @a Game::resetPhaseTimes.
+     * Pozwala porównać czas faz równoległych przy różnej liczbie wątków puli (tools/gamebench).
+     */
+    struct PhaseTimes
+    {
+        Uint64 detect_contacts; ///< @a Game::detectContacts
+        Uint64 resolve_contacts; ///< @a Game::resolveContacts
+        Uint64 tank_limits; ///< @a Game::updateTankLimits
+        Uint64 enemy_decisions; ///< @a Game::runEnemyDecisions
+        Uint32 updates; ///< liczba zmierzonych wywołań @a Game::update w trakcie rundy
+    };
+    /**
+     * @return czasy faz aktualizacji rundy
+     */
+    const PhaseTimes& phaseTimes() const;
+    /**
+     * Wyzerowanie czasów faz, np. po rozgrzaniu rundy.
+     */
+    void resetPhaseTimes();
 
 private:
     /**
-     * Wczytanie mapy poziomu z pliku
-     * @param path - ścieżka do pliku mapy
+     * @brief Rodzaj kontaktu wykrytego w fazie wykrywania kolizji. Kolejność wartości wyznacza kolejność rozstrzygania kontaktów.
+     */
+    enum ContactType
+    {
+        CT_BULLET_LEVEL, ///< pocisk czołgu @a first (indeks z @a Game::tankAt) o numerze @a second dotarł do przeszkody
+        CT_BULLET_BUSH, ///< pocisk gracza @a first o numerze @a second trafił w krzak
+        CT_PLAYER_BULLETS_ENEMY, ///< pocisk gracza @a first trafił przeciwnika @a second
+        CT_TWO_BULLETS, ///< pocisk @a third gracza @a first zderzył się z pociskiem @a fourth przeciwnika @a second
+        CT_ENEMY_BULLETS_PLAYER, ///< pocisk przeciwnika @a first trafił gracza @a second
+        CT_PLAYER_BONUS ///< gracz @a first najechał na bonus @a second
+    };
+
+    /**
+     * @brief Struktura opisująca kontakt między obiektami. Obiekty są wskazywane przez indeksy w kontenerach gry, znaczenie indeksów zależy od rodzaju kontaktu.
+     */
+    struct Contact
+    {
+        ContactType type;
+        int first;
+        int second;
+        int third;
+        int fourth;
+
+        /**
+         * Kanoniczny porządek kontaktów: rodzaj, a następnie kolejne indeksy.
+         */
+        bool operator<(const Contact& c) const;
+    };
+
+    /**
+     * @brief Ograniczenie ruchu czołgu w bieżącej klatce wyznaczone w fazie wykrywania kolizji.
+     */
+    struct TankLimit
+    {
+        /**
+         * Odległość do najbliższej przeszkody na drodze czołgu.
+         */
+        double distance;
+        /**
+         * Zmienna mówi czy czołg wjeżdża na lód.
+         */
+        bool on_ice;
+    };
+
+    /**
+     * Rozpoczęcie poziomu na podstawie wzorca: mapa wskazuje wiersze wzorca, a krzaki i orzełek są tworzone w pamięci poziomu.
+     * @param level_template - wzorzec poziomu
+     */
+    void instantiateLevel(std::shared_ptr<const LevelTemplate> level_template);
+    /**
+     * Pełne wyznaczenie pola odległości do orzełka i tablic linii strzału oraz porzucenie pól odległości do graczy, np. po postawieniu muru wokół orzełka, gdy przeszkód przybywa.
+     */
+    void rebuildNavigation();
+    /**
+     * Poprawienie pól odległości i tablic linii strzału po zniszczeniu przeszkody na polu mapy.
+     * @param row - wiersz pola
+     * @param column - kolumna pola
+     */
+    void updateNavigation(int row, int column);
+    /**
+     * Zgłoszenie oczekujących decyzji przeciwników do @a m_ai_scheduler i wykonanie ich w budżecie czasu @a AppConfig::ai_time_budget.
+     * Przed decyzją o kierunku jazdy wybierany jest cel; przeciwnik, którego cel zniknął, dostaje nowy cel od razu, niezależnie od budżetu.
+     * Decyzje porcji są wyznaczane przez @a Enemy::plan (przy @a AppConfig::parallel_ai_decisions równolegle na wątkach puli @a ThreadPool), a wykonywane szeregowo przez @a Enemy::apply,
+     * więc wynik nie zależy od liczby wątków.
+     */
+    void runEnemyDecisions();
+    /**
+     * Pierwszeństwo decyzji przeciwnika w @a m_ai_scheduler: odległość do najbliższego gracza lub orzełka pomniejszona o spóźnienie decyzji.
+     * @param enemy - przeciwnik
+     * @return pierwszeństwo; mniejsza wartość oznacza wcześniejszą decyzję
+     */
+    int decisionPriority(const Enemy* enemy);
+    /**
+     * Ustawienie @a Enemy::target_position na środek wybranego celu przeciwnika.
+     * @param enemy - przeciwnik
+     */
+    void updateTargetPosition(Enemy* enemy);
+    /**
+     * Wypełnienie @a m_player_index położeniami graczy, jeśli nie zostało wykonane w bieżącej klatce.
      */
-    void loadLevel(std::string path);
+    void indexPlayers();
+    /**
+     * Wybór celu przeciwnika: najbliższy gracz z @a m_player_index dla przeciwników typu A i D, jeśli jest bliżej niż orzełek, a w pozostałych przypadkach orzełek.
+     * @param enemy - przeciwnik
+     */
+    void assignTarget(Enemy* enemy);
+    /**
+     * Pole odległości do gracza; wyznaczane od nowa, gdy gracz przejedzie na inne pole mapy.
+     * @param player - gracz
+     * @return pole odległości
+     */
+    const FlowField* playerField(const Player* player);
+    /**
+     * Ponowne wczytanie zmienionego pliku bieżącego poziomu bez przerywania rozgrywki.
+     * Zmieniane są tylko pola i krzaki, które w pliku różnią się od poprzedniej wersji; uszkodzenia pozostałych murków, czołgi, pociski i liczniki czasu zostają.
+     * Nowy wzorzec zastępuje poprzedni również w pamięci podręcznej; zmiana rozmiaru mapy wymaga ponownego rozpoczęcia poziomu.
+     * @see AppConfig::level_hot_reload
+     */
+    void reloadLevel();
     /**
      * Usuwanie pozostałych wrogów, graczy, obiektów mapy oraz bonusów
      */
     void clearLevel();
     /**
      * Wczytanie nowego poziomu i utworzenie nowych graczy jeśli jeszcze nie istnieją.
-     * @see Game::loadLevel(std::string path)
+     * Wzorzec poziomu jest brany z pamięci podręcznej, a przy pierwszym użyciu poziomu tworzony z poziomu wczytanego w tle przez @a LevelLoader lub wczytanego od razu.
+     * Przy włączonym @a AppConfig::generated_levels poziom jest tworzony przez @a LevelGenerator.
+     * @see LevelTemplate::get
      */
     void nextLevel();
+    /**
+     * Rozpoczęcie rundy na podanym wzorcu poziomu i utworzenie nowych graczy jeśli jeszcze nie istnieją.
+     * @param level_template - wzorzec poziomu
+     */
+    void startLevel(std::shared_ptr<const LevelTemplate> level_template);
     /**
      * Tworzenie nowego wroga jeżeli liczba przeciwników na planszy jest mniejsza od 4 przy założeniu, że nie stworzono już wszystkich 20 wrogów na mapie.
      * Funkcja generuje różne poziomy pancerza wrogów w zależności od poziomu; im wyższy numer rundy tym większa szansa, żeby przeciwnik miał czwarty poziom pancerza.
@@ -97,31 +240,110 @@ private:
     void generateBonus();
 
     /**
-     * Sprawdzenie czy czołg może swobodnie jechać naprzód, jeżeli nie zatrzymuje go. Funkcja nie pozwala na wyjazd poza planszę.
-     * Jeżeli czołg wjechał na lód powoduje to jego poślizg. Jeżeli czołg posiada bonus "Łódź" może przechodzić przez wodę. Czołgi nie mogą przejechać orzełka.
+     * Zamiana murku wokół orzełka na kamienny. Jeżeli mur już stoi, uzupełniane są jedynie jego zniszczone fragmenty.
+     */
+    void buildEagleWall();
+    /**
+     * Zamiana kamiennego muru wokół orzełka z powrotem na nienaruszony murek z cegieł.
+     */
+    void removeEagleWall();
+    /**
+     * Położenie startowe gracza na bieżącym poziomie.
+     * @param index - numer gracza; jeśli poziom ma mniej położeń startowych, używane jest ostatnie z nich
+     * @return położenie startowe
+     */
+    SDL_Point playerStart(unsigned index) const;
+    /**
+     * Dostęp do pola mapy w celu odczytu.
+     * @param row - wiersz z przedziału [0, m_level_rows_count)
+     * @param column - kolumna z przedziału [0, m_level_columns_count)
+     * @return pole mapy
+     */
+    const Tile& tileAt(int row, int column) const;
+    /**
+     * Dostęp do pola mapy w celu zmiany. Przy pierwszej zmianie w danym wierszu wiersz wzorca jest kopiowany do pamięci poziomu.
+     * Odwołania do pól tego wiersza uzyskane wcześniej przez @a Game::tileAt przestają być aktualne.
+     * @param row - wiersz z przedziału [0, m_level_rows_count)
+     * @param column - kolumna z przedziału [0, m_level_columns_count)
+     * @return pole mapy
+     */
+    Tile& editTile(int row, int column);
+    /**
+     * Czołg o podanym indeksie; najpierw numerowani są przeciwnicy, a po nich gracze.
+     * @param index - indeks z przedziału [0, m_enemies.size() + m_players.size())
+     * @return wskaźnik na czołg
+     */
+    Tank* tankAt(int index) const;
+    /**
+     * Faza wykrywania kolizji pocisków, czołgów i bonusów. Sprawdzanie jest rozdzielane na wątki puli @a ThreadPool i nie zmienia stanu gry
+     * (poza odświeżeniem przewidywania zderzenia pocisku, należącego wyłącznie do sprawdzanego pocisku). Wykryte kontakty trafiają do @a m_contacts w kanonicznym porządku.
+     */
+    void detectContacts();
+    /**
+     * Faza rozstrzygania kontaktów z @a m_contacts. Kontakty są rozstrzygane szeregowo w kanonicznym porządku, dlatego wynik nie zależy od liczby wątków.
+     * Każdy kontakt jest ponownie sprawdzany, ponieważ wcześniej rozstrzygnięty kontakt mógł go unieważnić (np. pocisk już wybuchł).
+     */
+    void resolveContacts();
+    /**
+     * Równoległe wyznaczenie ograniczeń ruchu wszystkich czołgów (mapa, granice mapy, orzełek, inne czołgi) i ich zastosowanie.
+     * Wykonywane po @a Game::resolveContacts, aby uwzględnić zmiany mapy z bieżącej klatki.
+     * @param dt - czas trwania klatki
+     */
+    void updateTankLimits(Uint32 dt);
+
+    /**
+     * Wyznaczenie odległości, jaką czołg może przejechać w tej klatce zanim dotknie przeszkody; czołg dojeżdża dokładnie do przeszkody niezależnie od długości klatki.
+     * Funkcja nie pozwala na wyjazd poza planszę. Jeżeli czołg wjechał na lód powoduje to jego poślizg. Jeżeli czołg posiada bonus "Łódź" może przechodzić przez wodę. Czołgi nie mogą przejechać orzełka.
      * @param tank - czółg, dla którego sprawdzamy kolizje
-     * @param dt - ostatnia zmiana czasu, przy założeniu niewielkich zmian w kolejnych krokach czasowych możemy przewidywać kolejne położenie czołgu i odpowiednio reagować.
+     * @param dt - czas trwania klatki; wyznacza zasięg ruchu czołgu, a więc liczbę sprawdzanych komórek mapy
+     * @param limit - ograniczenie ruchu czołgu, zmniejszane o przeszkody z mapy
      */
-    void checkCollisionTankWithLevel(Tank* tank, Uint32 dt);
+    void checkCollisionTankWithLevel(const Tank* tank, Uint32 dt, TankLimit& limit) const;
     /**
-     * Sprawdzenie czy nie występuje kolizja między badanymi czołgami, jeśli tak oba są zatrzymywane.
-     * @param tank1
-     * @param tank2
-     * @param dt
+     * Ograniczenie ruchu pierwszego czołgu tak, aby zatrzymał się dokładnie przy drugim. Czołgi jadące naprzeciw siebie dzielą wolną przestrzeń po połowie.
+     * @param tank1 - czołg, którego ruch jest ograniczany
+     * @param motion1 - stan ruchu pierwszego czołgu (@a Tank::motion)
+     * @param tank2 - czołg będący przeszkodą
+     * @param motion2 - stan ruchu drugiego czołgu
+     * @param limit - ograniczenie ruchu pierwszego czołgu
      */
-    void checkCollisionTwoTanks(Tank* tank1, Tank* tank2, Uint32 dt);
+    void checkCollisionTwoTanks(const Tank* tank1, const Tank::Motion& motion1, const Tank* tank2, const Tank::Motion& motion2, TankLimit& limit) const;
     /**
      * Sprawdznie czy wybrany pocisk nie koliduje z jakimś elementem mapy (woda i lód są pomijane). Jeżeli tak pocisk i obiekt są niszczone.
      * Jeśli trafiono orzełka to następuje przegrana.
-     * @param bullet - pocisk
+     * @param bullet - położenie pocisku w @a m_bullets lub -1
+     */
+    void checkCollisionBulletWithLevel(int bullet);
+    /**
+     * Sprawdzenie bez modyfikacji mapy, czy pocisk dotarł do przewidzianej przeszkody i wymaga sprawdzenia kolizji z poziomem.
+     * @param bullet - położenie pocisku w @a m_bullets lub -1
+     * @return @a true jeżeli należy wywołać @a Game::checkCollisionBulletWithLevel
+     */
+    bool detectCollisionBulletWithLevel(int bullet);
+    /**
+     * Sprawdzenie bez modyfikacji obiektów, czy pocisk o zwiększonych obrażeniach trafia w krzak.
+     * @param bullet - położenie pocisku w @a m_bullets lub -1
+     * @return @a true jeżeli należy wywołać @a Game::checkCollisionBulletWithBush
      */
-    void checkCollisionBulletWithLevel(Bullet* bullet);
+    bool detectCollisionBulletWithBush(int bullet) const;
+    /**
+     * Wyznaczenie współrzędnej, przy której pocisk lecący po linii prostej dotrze do pierwszej przeszkody na swojej drodze (murek, kamień, orzełek, granica mapy).
+     * Wynik zapisywany jest w @a BulletStore::impactPosition razem z aktualną wersją mapy @a m_level_revision.
+     * @param bullet - położenie pocisku w @a m_bullets
+     */
+    void predictBulletImpact(int bullet);
+    /**
+     * Sprawdzenie czy pocisk doleciał do przewidzianego miejsca zderzenia lub wyleciał poza mapę.
+     * @param bullet - położenie pocisku z aktualnym przewidywaniem w @a m_bullets
+     * @return @a true jeżeli należy sprawdzić kolizję pocisku z poziomem
+     */
+    bool bulletImpactDue(int bullet) const;
     /**
      * Sprawdzenie kolizji pocisku z krzewami (krzakami) na mapie. Niszczenie krzaków i pocisku nastepuje wtedy, gdy ma on zwiększone obrażenia.
-     * @param bullet - pocisk
-     * @see Bullet::increased_damage
+     * @param bullet - położenie pocisku w @a m_bullets lub -1
+     * @see BulletStore::BF_INCREASED_DAMAGE
      */
-    void checkCollisionBulletWithBush(Bullet* bullet);
+    void checkCollisionBulletWithBush(int bullet);
     /**
      * Sprawdzanie czy dany gracz trafił w wybranego przeciwnika. Jeśli tak gracz dostaje punkty a przeciwnik traci jeden poziom pancerza.
      * @param player - gracz
@@ -136,10 +358,20 @@ private:
     void checkCollisionEnemyBulletsWithPlayer(Enemy* enemy, Player* player);
     /**
      * Jeżeli dwa pociski się zderzą oba zostają niszczone.
-     * @param bullet1
-     * @param bullet2
+     * @param bullet1 - położenie pierwszego pocisku w @a m_bullets lub -1
+     * @param bullet2 - położenie drugiego pocisku w @a m_bullets lub -1
      */
-    void checkCollisionTwoBullets(Bullet* bullet1, Bullet* bullet2);
+    void checkCollisionTwoBullets(int bullet1, int bullet2);
+    /**
+     * @param tank - czołg
+     * @param number - numer pocisku w @a Tank::bullets
+     * @return położenie pocisku w @a m_bullets lub -1
+     */
+    int bulletOf(const Tank* tank, unsigned number) const;
+    /**
+     * Rezerwacja miejsca w @a m_bullets na wszystkie pociski, jakie mogą jednocześnie mieć czołgi na mapie.
+     */
+    void reserveBullets();
     /**
      * Sprawdzenie czy gracz nie wziął bonusu. Jeśli tak następuje odpowiednia reakcja:
      * @li Granat - widoczni wrogowie zostają zniszczeni
@@ -165,30 +397,126 @@ private:
      */
     int m_level_rows_count;
     /**
-     * Przeszkody na mapie.
+     * Współdzielony wzorzec bieżącego poziomu.
      */
-    std::vector< std::vector <Object*> > m_level;
+    std::shared_ptr<const LevelTemplate> m_level_template;
+    /**
+     * Wiersze mapy: wskazują wiersze wzorca lub ich kopie w pamięci poziomu.
+     * @see Game::tileAt(int row, int column)
+     */
+    std::vector<const Tile*> m_level_rows;
+    /**
+     * Kopie wierszy zmienionych w tej rozgrywce lub nullptr dla wierszy niezmienionych.
+     * @see Game::editTile(int row, int column)
+     */
+    std::vector<Tile*> m_level_copies;
+    /**
+     * Wymiary planszy bieżącego poziomu; wyznaczają granice ruchu czołgów i pocisków.
+     */
+    SDL_Rect m_map_rect;
+    /**
+     * Czas od ostatniej zmiany klatki animacji pól mapy.
+     */
+    Uint32 m_tile_frame_time;
+    /**
+     * Klatka animacji pól mapy; wszystkie pola wody są animowane jednocześnie.
+     */
+    int m_tile_frame;
+    /**
+     * Kontakty wykryte w bieżącej klatce w kanonicznym porządku.
+     */
+    std::vector<Contact> m_contacts;
+    /**
+     * Kontakty wykryte przez poszczególne wątki; kontenery są zachowywane między klatkami, aby nie alokować pamięci.
+     */
+    std::vector< std::vector<Contact> > m_worker_contacts;
+    /**
+     * Liczba kontaktów, na którą z góry rezerwowane jest miejsce w @a m_contacts i w każdym z @a m_worker_contacts.
+     */
+    static const unsigned contacts_reserve = 64;
+    /**
+     * Ograniczenia ruchu czołgów w kolejności @a Game::tankAt.
+     */
+    std::vector<TankLimit> m_tank_limits;
+    /**
+     * Stan ruchu czołgów w kolejności @a Game::tankAt, odczytany z magazynu raz na klatkę przed sprawdzaniem par czołgów.
+     */
+    std::vector<Tank::Motion> m_tank_motions;
+    /**
+     * Wersja mapy zwiększana przy każdej zmianie przeszkód w @a m_level_rows; unieważnia przewidywania zderzeń pocisków.
+     */
+    int m_level_revision;
     /**
      * Krzaki na mapie.
      */
     std::vector<Object*> m_bushes;
+    /**
+     * Pole odległości do orzełka, według którego jadą przeciwnicy.
+     */
+    FlowField m_eagle_field;
+    /**
+     * Pola odległości do pierwszego i drugiego gracza, według których jadą przeciwnicy typu A i D.
+     */
+    std::vector<FlowField> m_player_fields;
+    /**
+     * Przeszkody na liniach strzału, według których przeciwnicy decydują o wystrzale.
+     */
+    LineOfSight m_line_of_sight;
+    /**
+     * Położenia graczy w siatce kubełków, z której przeciwnicy wybierają najbliższego gracza; wypełniana co najwyżej raz na klatkę, przy pierwszym użyciu.
+     */
+    SpatialGrid<SlotMap<Player*>::Handle> m_player_index;
+    /**
+     * Zmienna mówi czy @a m_player_index zawiera położenia graczy z bieżącej klatki.
+     */
+    bool m_players_indexed;
+    /**
+     * Kolejka decyzji przeciwników wykonywanych w ograniczonym czasie na klatkę.
+     */
+    AiScheduler m_ai_scheduler;
+    /**
+     * Zamiary przeciwników z bieżącej porcji decyzji, wyznaczane równolegle przez @a Enemy::plan.
+     */
+    std::vector<EnemyIntent> m_enemy_intents;
+    /**
+     * Liczba decyzji przeciwników na wątek w jednej porcji @a AiScheduler przy ograniczonym czasie decyzji.
+     * Wartość nie była dobierana pomiarem na procesorze wielordzeniowym.
+     */
+    static const unsigned decisions_per_thread = 8;
+    /**
+     * Najmniejsza liczba decyzji w porcji, którą przy @a AppConfig::parallel_ai_decisions rozdziela się na wątki puli.
+     * Wartość nie była dobierana pomiarem na procesorze wielordzeniowym.
+     */
+    static const unsigned parallel_decisions_min = 16;
 
     /**
-     * Zbiór wrogów.
+     * Pociski wszystkich czołgów na mapie; czołgi przechowują jedynie ich uchwyty.
+     */
+    BulletStore m_bullets;
+    /**
+     * Stan ruchu wrogów i pozostałych graczy; obiekty czołgów przechowują jedynie jego uchwyty.
      */
-    std::vector<Enemy*> m_enemies;
+    TankStore m_tanks;
     /**
-     * Zbiór pozostałych graczy.
+     * Stan ruchu zabitych graczy, którzy nie są już aktualizowani.
      */
-    std::vector<Player*> m_players;
+    TankStore m_killed_tanks;
+    /**
+     * Zbiór wrogów; wrogowie mogą być wskazywani uchwytami z @a SlotMap.
+     */
+    SlotMap<Enemy*> m_enemies;
+    /**
+     * Zbiór pozostałych graczy; przeciwnicy wskazują wybranego gracza uchwytem z @a SlotMap.
+     */
+    SlotMap<Player*> m_players;
     /**
      * Zbiór zabity graczy.
      */
     std::vector<Player*> m_killed_players;
     /**
-     * Zbiór bonusów na mapie.
+     * Zbiór bonusów na mapie; bonusy mogą być wskazywane uchwytami z @a SlotMap.
      */
-    std::vector<Bonus*> m_bonuses;
+    SlotMap<Bonus*> m_bonuses;
     /**
      * Obiekt orzełka.
      */
@@ -206,6 +534,10 @@ private:
      * Liczba pozostałych wrogów do zabicia na danym poziomie
      */
     int m_enemy_to_kill;
+    /**
+     * Liczba wrogów z listy @a LevelTemplate::roster, którzy pojawili się już na danym poziomie; wskazuje następny wpis listy.
+     */
+    unsigned m_roster_spawned;
 
     /**
      * Zmienna przechowyje, czy w tym momencie wyświetlany jest ekran startowy poziomu.
@@ -215,10 +547,22 @@ private:
      * Zmienna przechowuje informacje, czy orzełek jest chroniony kamiennym murem.
      */
     bool m_protect_eagle;
+    /**
+     * Pamięć obiektów żyjących tyle co poziom: krzaków, orzełka i zmienionych wierszy mapy. Zwalniana w całości w @a Game::clearLevel.
+     */
+    Arena m_level_arena;
+    /**
+     * Obserwacja pliku bieżącego poziomu, gdy włączone jest @a AppConfig::level_hot_reload.
+     */
+    FileWatcher m_level_watcher;
     /**
      * Czas jak długo wyświetlany jest już ekran startowy poziomu.
      */
     Uint32 m_level_start_time;
+    /**
+     * Czas trwania rundy liczony od zniknięcia ekranu startowego, bez przerw na pauzę.
+     */
+    Uint32 m_level_time;
     /**
      * Czas od ostatniego stworzenia przeciwnika.
      */
@@ -248,10 +592,18 @@ private:
      * Zmienna mówi czy włączona została pauza.
      */
     bool m_pause;
+    /**
+     * Czasy faz aktualizacji rundy.
+     */
+    PhaseTimes m_phase_times;
     /**
      * Numer pozycji now stworzonego przeciwnika. Zmieniana przy każdym tworzeniu przeciwnika.
      */
     int m_enemy_respown_position;
+    /**
+     * Liczba przeciwników i bonusów stworzonych od początku gry.
+     */
+    unsigned m_spawned_count;
 };
 
 #endif // GAME_H
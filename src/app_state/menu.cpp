@@ -13,16 +13,19 @@ Menu::Menu()
     m_menu_texts.push_back("2 Players");
     m_menu_texts.push_back("Exit");
     m_menu_index = 0;
-    m_tank_pointer = new Player(0, 0 , ST_PLAYER_1);
-    m_tank_pointer->direction = D_RIGHT;
-    m_tank_pointer->pos_x = 144;
-    m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 112;
+    m_tank_pointer = new Player(&m_tanks, 0, 0 , ST_PLAYER_1);
+    m_tank_pointer->setDirection(D_RIGHT);
+    m_tank_pointer->setPosition(144, (m_menu_index + 1) * 32 + 112);
     m_tank_pointer->setFlag(TSF_LIFE);
+    m_tanks.update(0);
     m_tank_pointer->update(0);
     m_tank_pointer->clearFlag(TSF_LIFE);
     m_tank_pointer->clearFlag(TSF_SHIELD);
     m_tank_pointer->setFlag(TSF_MENU);
     m_finished = false;
+    //pierwsza runda jest wczytywana w tle, zanim gracz wybierze tryb gry
+    if(LevelTemplate::cached(Game::levelAfter(0)) == nullptr)
+        Engine::getEngine().getLevelLoader()->request(Game::levelAfter(0));
 }
 
 Menu::~Menu()
@@ -45,11 +48,11 @@ void Menu::draw()
 
     int i = 0;
     SDL_Point text_start;
-    for(auto text : m_menu_texts)
+    for(auto& text : m_menu_texts)
     {
         text_start = { 180, (i + 1) * 32 + 120};
         i++;
-        renderer->drawText(&text_start, text, {255, 255, 255, 255}, 2);
+        renderer->drawText(&text_start, text.c_str(), {255, 255, 255, 255}, 2);
     }
 
     m_tank_pointer->draw();
@@ -59,8 +62,9 @@ void Menu::draw()
 
 void Menu::update(Uint32 dt)
 {
-    m_tank_pointer->speed = m_tank_pointer->default_speed;
-    m_tank_pointer->stop = true;
+    m_tank_pointer->setSpeed(m_tank_pointer->default_speed);
+    m_tank_pointer->setStopped(true);
+    m_tanks.update(dt);
     m_tank_pointer->update(dt);
 }
 
@@ -74,7 +78,7 @@ void Menu::eventProcess(SDL_Event *ev)
             if(m_menu_index < 0)
                 m_menu_index = m_menu_texts.size() - 1;
 
-            m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 110;
+            m_tank_pointer->setPosition(m_tank_pointer->posX(), (m_menu_index + 1) * 32 + 110);
         }
         else if(ev->key.keysym.sym == SDLK_DOWN)
         {
@@ -82,7 +86,7 @@ void Menu::eventProcess(SDL_Event *ev)
             if(m_menu_index >= m_menu_texts.size())
                 m_menu_index = 0;
 
-            m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 110;
+            m_tank_pointer->setPosition(m_tank_pointer->posX(), (m_menu_index + 1) * 32 + 110);
         }
         else if(ev->key.keysym.sym == SDLK_SPACE || ev->key.keysym.sym == SDLK_RETURN)
         {
@@ -53,6 +53,10 @@ private:
      * Indeks wybranej pozycji menu.
      */
     int m_menu_index;
+    /**
+     * Stan ruchu czołgu wskaźnika.
+     */
+    TankStore m_tanks;
     /**
      * Zmienna odpowiadająca za wskaźnik w postaci czołgu.
      */
@@ -25,6 +25,7 @@ Scores::Scores(std::vector<Player *> players, int level, bool game_over)
     m_max_score = 0;
     for(auto player : m_players)
     {
+        player->attach(&m_tanks);
         player->to_erase = false;
         if(player->lives_count == 0 && !game_over) player->lives_count = 2;
         else player->lives_count++;
@@ -33,11 +34,15 @@ Scores::Scores(std::vector<Player *> players, int level, bool game_over)
 
         if(player->score > m_max_score) m_max_score = player->score;
     }
+    //kolejna runda, jeśli nie była jeszcze grana, jest wczytywana w tle podczas liczenia punktów
+    if(!m_game_over && LevelTemplate::cached(Game::levelAfter(m_level)) == nullptr)
+        Engine::getEngine().getLevelLoader()->request(Game::levelAfter(m_level));
 }
 
 void Scores::draw()
 {
-    Renderer* renderer = Engine::getEngine().getRenderer();
+    Engine& engine = Engine::getEngine();
+    Renderer* renderer = engine.getRenderer();
     renderer->clear();
 
     renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 255}, true);
@@ -47,11 +52,11 @@ void Scores::draw()
     SDL_Rect dst;
 
     p_dst = {-1, 10};
-    renderer->drawText(&p_dst, std::string("STAGE ") + Engine::intToString(m_level), {255, 255, 220, 255}, 1);
+    renderer->drawText(&p_dst, engine.frameText("STAGE ", m_level), {255, 255, 220, 255}, 1);
     p_dst = {100, 50};
-    renderer->drawText(&p_dst, std::string("PLAYER"), {255, 255, 255, 255}, 2);
+    renderer->drawText(&p_dst, "PLAYER", {255, 255, 255, 255}, 2);
     p_dst = {270, 50};
-    renderer->drawText(&p_dst, std::string("SCORE"), {255, 255, 255, 255}, 2);
+    renderer->drawText(&p_dst, "SCORE", {255, 255, 255, 255}, 2);
     dst = {75, 75, 300, 2};
     renderer->drawRect(&dst, {250, 250, 200, 255}, true);
     int i = 0;
@@ -60,9 +65,9 @@ void Scores::draw()
         dst = {100, 90 + i * (player->src_rect.h), player->src_rect.w, player->src_rect.h};
         renderer->drawObject(&player->src_rect, &dst);
         p_dst = {140, 98 + i * (player->src_rect.h)};
-        renderer->drawText(&p_dst, std::string("x") + Engine::intToString(player->lives_count), {255, 255, 255, 255}, 2);
+        renderer->drawText(&p_dst, engine.frameText("x", player->lives_count), {255, 255, 255, 255}, 2);
         p_dst = {270, 98 + i * (player->src_rect.h)};
-        renderer->drawText(&p_dst, (m_score_counter < player->score ? Engine::intToString(m_score_counter) : Engine::intToString(player->score)), {255, 255, 255, 255}, 2);
+        renderer->drawText(&p_dst, engine.frameText("", m_score_counter < player->score ? m_score_counter : player->score), {255, 255, 255, 255}, 2);
         i++;
     }
 
@@ -87,11 +92,12 @@ void Scores::update(Uint32 dt)
     }
     for(auto player : m_players)
     {
-        player->speed = player->default_speed;
-        player->stop = true;
+        player->setSpeed(player->default_speed);
+        player->setStopped(true);
         player->setDirection(D_RIGHT);
-        player->update(dt);
     }
+    m_tanks.update(dt);
+    for(auto player : m_players) player->update(dt);
 }
 
 void Scores::eventProcess(SDL_Event *ev)
@@ -51,6 +51,10 @@ private:
      * Kontener z wszystkimi graczami (zabitymi i niezabitymi).
      */
     std::vector<Player*> m_players;
+    /**
+     * Stan ruchu czołgów graczy przeniesiony z zakończonej rundy.
+     */
+    TankStore m_tanks;
     /**
      * Numer ostatniego poziomu.
      */
@@ -2,7 +2,11 @@
 
 string AppConfig::texture_path = "texture.png";
 string AppConfig::levels_path = "levels/";
+string AppConfig::level_pack_path = "levels.pack";
 string AppConfig::font_name = "prstartk.ttf";
+string AppConfig::assets_path = "assets.bin";
+string AppConfig::sprites_path = "sprites";
+string AppConfig::sprite_cache_path = "sprites.cache";
 string AppConfig::game_over_text = "GAME OVER";
 SDL_Rect AppConfig::map_rect = {0, 0, 26*16, 26*16};
 SDL_Rect AppConfig::status_rect = {26*16, 0, 3*16, AppConfig::map_rect.h};
@@ -53,6 +57,14 @@ unsigned AppConfig::protect_eagle_time = 15000;
 unsigned AppConfig::bonus_blink_time = 350;
 unsigned AppConfig::player_reload_time = 120;
 int AppConfig::enemy_max_count_on_map = 4;
+unsigned AppConfig::worker_threads = 0;
+unsigned AppConfig::alloc_assert_warmup_time = 1000;
+unsigned AppConfig::ai_time_budget = 0;
+bool AppConfig::parallel_ai_decisions = false;
+bool AppConfig::startup_report = false;
+bool AppConfig::level_hot_reload = false;
+bool AppConfig::generated_levels = false;
+unsigned AppConfig::generator_seed = 0;
 double AppConfig::game_over_entry_speed = 0.13;
 double AppConfig::tank_default_speed = 0.08;
 double AppConfig::bullet_default_speed = 0.23;
@@ -22,10 +22,30 @@ public:
      * Ścieżka do katalogu z poziomami.
      */
     static string levels_path;
+    /**
+     * Ścieżka do paczki poziomów; jeśli paczki nie ma, poziomy są wczytywane z katalogu @a AppConfig::levels_path.
+     * @see LevelPack
+     */
+    static string level_pack_path;
     /**
      * Ścieżka do czcionki.
      */
     static string font_name;
+    /**
+     * Ścieżka do pliku zasobów ze zdekodowaną teksturą i czcionkami narysowanymi jako arkusze znaków;
+     * jeśli pliku nie ma, tekstura i czcionka są wczytywane z plików @a AppConfig::texture_path i @a AppConfig::font_name.
+     * @see AssetPack
+     */
+    static string assets_path;
+    /**
+     * Ścieżka do katalogu z dodatkowymi obrazkami PNG (np. skórkami); obrazki o nazwach sprite'ów z @a SpriteConfig zastępują ich wygląd.
+     * @see SpriteAtlas
+     */
+    static string sprites_path;
+    /**
+     * Ścieżka do pliku podręcznego z teksturą złożoną z obrazkami z katalogu @a AppConfig::sprites_path.
+     */
+    static string sprite_cache_path;
     /**
      * Tekst wyświetlany po przegranej.
      */
@@ -114,6 +134,44 @@ public:
      * Maksymalna liczba czołgów na mapie w jednej chwili.
      */
     static int enemy_max_count_on_map;
+    /**
+     * Liczba wątków wykorzystywanych do równoległych obliczeń (np. wykrywania kolizji); wartość 0 oznacza liczbę rdzeni procesora.
+     */
+    static unsigned worker_threads;
+    /**
+     * Czas od rozpoczęcia rundy, po którym w programie zbudowanym z flagą ALLOC_ASSERT każdy przydział pamięci w klatce, w której nie pojawił się ani nie zniknął żaden obiekt, przerywa działanie programu.
+     */
+    static unsigned alloc_assert_warmup_time;
+    /**
+     * Czas w mikrosekundach, jaki w jednej klatce mogą zająć decyzje przeciwników (wybór celu, kierunku jazdy i wystrzału); decyzje, na które zabrakło czasu, są podejmowane w kolejnych klatkach.
+     * Wartość 0 oznacza brak ograniczenia, przy którym przebieg gry nie zależy od szybkości komputera; ustawiana opcją --ai-budget.
+     * @see AiScheduler
+     */
+    static unsigned ai_time_budget;
+    /**
+     * Zmienna mówi czy decyzje przeciwników są wyznaczane równolegle na wątkach puli; ustawiana opcją --parallel-ai.
+     * Domyślnie decyzje są wyznaczane szeregowo, bo zysk z rozdzielenia ich na wątki nie został zmierzony na procesorze wielordzeniowym (tools/gamebench).
+     * Przebieg gry nie zależy od tej opcji.
+     */
+    static bool parallel_ai_decisions;
+    /**
+     * Zmienna mówi czy po narysowaniu pierwszej klatki wypisać czasy etapów uruchamiania programu; ustawiana opcją --startup-report.
+     * @see StartupTimeline
+     */
+    static bool startup_report;
+    /**
+     * Zmienna mówi czy plik bieżącego poziomu z katalogu @a AppConfig::levels_path jest obserwowany i po zapisaniu wczytywany ponownie w trakcie gry; ustawiana opcją --hot-reload.
+     * @see Game::reloadLevel
+     */
+    static bool level_hot_reload;
+    /**
+     * Zmienna mówi czy zamiast poziomów z plików gra korzysta z poziomów tworzonych w pamięci przez @a LevelGenerator; ustawiana opcją --generate.
+     */
+    static bool generated_levels;
+    /**
+     * Ziarno serii poziomów losowych; runda n korzysta z ziarna @a LevelGenerator::levelSeed(generator_seed, n).
+     */
+    static unsigned generator_seed;
     /**
      * Prędkość poruszania się napsu "GAME OVER".
      */
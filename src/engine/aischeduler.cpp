@@ -0,0 +1,23 @@
+#include "aischeduler.h"
+
+AiScheduler::AiScheduler()
+{
+    m_order = 0;
+}
+
+void AiScheduler::reserve(unsigned count)
+{
+    m_tasks.reserve(count);
+    m_batch.reserve(count);
+}
+
+void AiScheduler::add(unsigned index, int priority)
+{
+    m_tasks.push_back({priority, m_order++, index});
+}
+
+bool AiScheduler::later(const Task& a, const Task& b)
+{
+    if(a.priority != b.priority) return a.priority > b.priority;
+    return a.order > b.order;
+}
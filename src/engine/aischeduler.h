@@ -0,0 +1,100 @@
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <vector>
+
+/**
+ * @brief
+ * Kolejka decyzji sztucznej inteligencji (wyboru celu, kierunku jazdy i wystrzału) wykonywanych w każdej klatce w ograniczonym czasie.
+ * Decyzje są wykonywane od najważniejszej; te, na które zabrakło czasu, są usuwane z kolejki, a zgłaszający ponawia je w kolejnej klatce.
+ * Kolejka jest kopcem, więc przy małym budżecie koszt klatki zależy od liczby wykonanych decyzji, a nie od sortowania wszystkich zgłoszonych.
+ * Decyzje są przekazywane porcjami, aby zadanie mogło wyznaczać decyzje jednej porcji równolegle; budżet jest sprawdzany pomiędzy porcjami.
+ */
+class AiScheduler
+{
+public:
+    AiScheduler();
+
+    /**
+     * Przygotowanie miejsca na zgłoszenia, aby ich dodawanie w kolejnych klatkach nie przydzielało pamięci.
+     * @param count - liczba zgłoszeń
+     */
+    void reserve(unsigned count);
+    /**
+     * Zgłoszenie decyzji do wykonania w bieżącej klatce.
+     * @param index - numer zgłaszającego przekazywany do zadania w @a AiScheduler::run
+     * @param priority - pierwszeństwo; mniejsza wartość oznacza wcześniejsze wykonanie, a przy równych wartościach pierwsze jest wcześniejsze zgłoszenie
+     */
+    void add(unsigned index, int priority);
+    /**
+     * Wykonanie zgłoszonych decyzji od najważniejszej aż do wyczerpania budżetu czasu i opróżnienie kolejki. Zawsze wykonywana jest co najmniej jedna porcja.
+     * Bez ograniczenia czasu wszystkie decyzje trafiają do jednej porcji w kolejności zgłoszenia, bo pierwszeństwo nie ma wtedy znaczenia.
+     * @param budget - budżet czasu w mikrosekundach; 0 oznacza wykonanie wszystkich decyzji
+     * @param batch_size - największa liczba decyzji w porcji przy ograniczonym czasie
+     * @param decide - zadanie wywoływane z wektorem numerów zgłaszających należących do porcji, uporządkowanym od najważniejszego
+     * @return liczbę wykonanych decyzji
+     */
+    template <class F>
+    unsigned run(Uint32 budget, unsigned batch_size, F decide)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        Uint64 limit = static_cast<Uint64>(budget) * SDL_GetPerformanceFrequency() / 1000000;
+        unsigned done = 0;
+        if(budget == 0)
+        {
+            m_batch.clear();
+            for(auto& task : m_tasks) m_batch.push_back(task.index);
+            m_tasks.clear();
+            if(!m_batch.empty()) decide(m_batch);
+            done = m_batch.size();
+        }
+        std::make_heap(m_tasks.begin(), m_tasks.end(), later);
+        while(!m_tasks.empty())
+        {
+            if(done > 0 && SDL_GetPerformanceCounter() - start >= limit) break;
+            m_batch.clear();
+            while(!m_tasks.empty() && m_batch.size() < std::max(batch_size, 1u))
+            {
+                std::pop_heap(m_tasks.begin(), m_tasks.end(), later);
+                m_batch.push_back(m_tasks.back().index);
+                m_tasks.pop_back();
+            }
+            decide(m_batch);
+            done += m_batch.size();
+        }
+        m_tasks.clear();
+        m_order = 0;
+        return done;
+    }
+
+private:
+    /**
+     * @brief Zgłoszona decyzja.
+     */
+    struct Task
+    {
+        int priority;
+        /**
+         * Kolejność zgłoszenia; rozstrzyga o pierwszeństwie przy równych wartościach @a priority.
+         */
+        unsigned order;
+        unsigned index;
+    };
+
+    /**
+     * Porównanie dla kopca: na szczycie jest zgłoszenie o najmniejszym pierwszeństwie, a spośród równych zgłoszone najwcześniej.
+     * @return true jeśli @a a ma być wykonane później niż @a b
+     */
+    static bool later(const Task& a, const Task& b);
+
+    std::vector<Task> m_tasks;
+    /**
+     * Numery zgłaszających w bieżącej porcji.
+     */
+    std::vector<unsigned> m_batch;
+    unsigned m_order;
+};
+
+#endif // AISCHEDULER_H
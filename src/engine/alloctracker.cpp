@@ -0,0 +1,135 @@
+#include "alloctracker.h"
+#include <cstdlib>
+#include <new>
+
+//liczniki są zwykłymi tablicami, aby były gotowe przed wywołaniem jakiegokolwiek konstruktora obiektów statycznych
+static AllocPhase s_phase = AP_OTHER;
+static SDL_atomic_t s_allocations[AP_COUNT];
+static SDL_atomic_t s_bytes[AP_COUNT];
+static SDL_atomic_t s_frees[AP_COUNT];
+static AllocStats s_last_frame[AP_COUNT];
+static Uint64 s_total_allocations[AP_COUNT];
+static Uint64 s_total_bytes[AP_COUNT];
+static Uint32 s_max_allocations[AP_COUNT];
+static Uint64 s_frames = 0;
+
+bool AllocTracker::enabled()
+{
+#ifdef ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocPhase AllocTracker::phase()
+{
+    return s_phase;
+}
+
+void AllocTracker::setPhase(AllocPhase phase)
+{
+    s_phase = phase;
+}
+
+void AllocTracker::recordAllocation(std::size_t size)
+{
+    SDL_AtomicAdd(&s_allocations[s_phase], 1);
+    SDL_AtomicAdd(&s_bytes[s_phase], size);
+}
+
+void AllocTracker::recordFree()
+{
+    SDL_AtomicAdd(&s_frees[s_phase], 1);
+}
+
+void AllocTracker::nextFrame()
+{
+    for(int i = 0; i < AP_COUNT; i++)
+    {
+        AllocStats& stats = s_last_frame[i];
+        stats.allocations = SDL_AtomicSet(&s_allocations[i], 0);
+        stats.bytes = SDL_AtomicSet(&s_bytes[i], 0);
+        stats.frees = SDL_AtomicSet(&s_frees[i], 0);
+
+        s_total_allocations[i] += stats.allocations;
+        s_total_bytes[i] += stats.bytes;
+        if(stats.allocations > s_max_allocations[i]) s_max_allocations[i] = stats.allocations;
+    }
+    s_frames++;
+}
+
+Uint32 AllocTracker::frameAllocations()
+{
+    Uint32 sum = 0;
+    for(int i = 0; i < AP_COUNT; i++) sum += SDL_AtomicGet(&s_allocations[i]);
+    return sum;
+}
+
+AllocStats AllocTracker::lastFrame(AllocPhase phase)
+{
+    return s_last_frame[phase];
+}
+
+const char* AllocTracker::phaseName(AllocPhase phase)
+{
+    switch(phase)
+    {
+    case AP_OTHER: return "OTHER";
+    case AP_COLLISION: return "COLLISION";
+    case AP_OBJECT_UPDATE: return "UPDATE";
+    case AP_CLEANUP: return "CLEANUP";
+    case AP_DRAW: return "DRAW";
+    case AP_DRAW_TEXT: return "TEXT";
+    default: return "?";
+    }
+}
+
+void AllocTracker::printFrame(std::ostream& out)
+{
+    for(int i = 0; i < AP_COUNT; i++)
+        out << phaseName(static_cast<AllocPhase>(i)) << ": " << SDL_AtomicGet(&s_allocations[i]) << " new, "
+            << SDL_AtomicGet(&s_bytes[i]) << " B, " << SDL_AtomicGet(&s_frees[i]) << " delete" << std::endl;
+}
+
+void AllocTracker::report(std::ostream& out)
+{
+    out << "allocations in " << s_frames << " frames:" << std::endl;
+    for(int i = 0; i < AP_COUNT; i++)
+    {
+        out << phaseName(static_cast<AllocPhase>(i)) << ": " << s_total_allocations[i] << " new, " << s_total_bytes[i] << " B";
+        if(s_frames > 0)
+            out << " (" << static_cast<double>(s_total_allocations[i]) / s_frames << " new, "
+                << static_cast<double>(s_total_bytes[i]) / s_frames << " B per frame, max " << s_max_allocations[i] << " new)";
+        out << std::endl;
+    }
+}
+
+#ifdef ALLOC_TRACKING
+
+void* operator new(std::size_t size)
+{
+    AllocTracker::recordAllocation(size);
+    void* ptr = std::malloc(size ? size : 1);
+    if(ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if(ptr == nullptr) return;
+    AllocTracker::recordFree();
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <SDL2/SDL.h>
+#include <ostream>
+
+/**
+ * Fazy działania programu, do których przypisywane są przydziały pamięci.
+ */
+enum AllocPhase
+{
+    AP_OTHER,
+    AP_COLLISION,
+    AP_OBJECT_UPDATE,
+    AP_CLEANUP,
+    AP_DRAW,
+    AP_DRAW_TEXT,
+    AP_COUNT
+};
+
+/**
+ * @brief Liczniki przydziałów pamięci jednej fazy.
+ */
+struct AllocStats
+{
+    /**
+     * Liczba wywołań operatora new.
+     */
+    Uint32 allocations;
+    /**
+     * Liczba przydzielonych bajtów.
+     */
+    Uint32 bytes;
+    /**
+     * Liczba wywołań operatora delete.
+     */
+    Uint32 frees;
+};
+
+/**
+ * @brief
+ * Klasa zlicza przydziały pamięci ze sterty z podziałem na fazy klatki.
+ * Zliczanie działa jedynie w programie zbudowanym z flagą ALLOC_TRACKING, która podmienia globalne operatory new i delete; bez niej wszystkie liczniki pozostają zerowe.
+ * Przydziały z wątków roboczych są przypisywane do fazy ustawionej w wątku głównym.
+ */
+class AllocTracker
+{
+public:
+    /**
+     * @return true jeśli program został zbudowany z flagą ALLOC_TRACKING
+     */
+    static bool enabled();
+    /**
+     * @return aktualną fazę
+     */
+    static AllocPhase phase();
+    /**
+     * Zmiana aktualnej fazy; wywoływana jedynie w wątku głównym.
+     * @param phase - nowa faza
+     */
+    static void setPhase(AllocPhase phase);
+    /**
+     * Zapisanie przydziału w aktualnej fazie.
+     * @param size - liczba bajtów
+     */
+    static void recordAllocation(std::size_t size);
+    /**
+     * Zapisanie zwolnienia pamięci w aktualnej fazie.
+     */
+    static void recordFree();
+    /**
+     * Zamknięcie bieżącej klatki: liczniki klatki są przepisywane do @a AllocTracker::lastFrame i dodawane do sum, a następnie zerowane.
+     */
+    static void nextFrame();
+    /**
+     * @return liczbę przydziałów we wszystkich fazach od początku bieżącej klatki
+     */
+    static Uint32 frameAllocations();
+    /**
+     * @param phase - faza
+     * @return liczniki fazy z poprzedniej klatki
+     */
+    static AllocStats lastFrame(AllocPhase phase);
+    /**
+     * @param phase - faza
+     * @return krótka nazwa fazy
+     */
+    static const char* phaseName(AllocPhase phase);
+    /**
+     * Wypisanie liczników bieżącej klatki; wykorzystywane przy zgłaszaniu przydziału w stanie ustalonym.
+     * @param out - strumień wyjściowy
+     */
+    static void printFrame(std::ostream& out);
+    /**
+     * Wypisanie sum i średnich na klatkę dla wszystkich faz.
+     * @param out - strumień wyjściowy
+     */
+    static void report(std::ostream& out);
+};
+
+/**
+ * @brief
+ * Obiekt ustawia fazę na czas swojego życia i przywraca poprzednią fazę w destruktorze.
+ */
+class AllocPhaseScope
+{
+public:
+    AllocPhaseScope(AllocPhase phase)
+    {
+        m_previous = AllocTracker::phase();
+        AllocTracker::setPhase(phase);
+    }
+    ~AllocPhaseScope()
+    {
+        AllocTracker::setPhase(m_previous);
+    }
+
+private:
+    AllocPhase m_previous;
+};
+
+#endif // ALLOCTRACKER_H
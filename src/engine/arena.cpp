@@ -0,0 +1,56 @@
+#include "arena.h"
+
+Arena::Arena(std::size_t block_size)
+{
+    m_block_size = block_size;
+    m_current = 0;
+    m_offset = 0;
+    m_used_before = 0;
+}
+
+Arena::~Arena()
+{
+    for(auto& block : m_blocks) delete[] block.data;
+    m_blocks.clear();
+}
+
+void* Arena::allocate(std::size_t size, std::size_t align)
+{
+    while(m_current < m_blocks.size())
+    {
+        Block& block = m_blocks.at(m_current);
+        std::size_t start = (reinterpret_cast<std::size_t>(block.data) + m_offset + align - 1) & ~(align - 1);
+        start -= reinterpret_cast<std::size_t>(block.data);
+        if(start + size <= block.size)
+        {
+            m_offset = start + size;
+            return block.data + start;
+        }
+        //brak miejsca w bieżącym bloku; przechodzimy do następnego
+        m_used_before += m_offset;
+        m_current++;
+        m_offset = 0;
+    }
+
+    //obiekty większe od bloku dostają własny blok
+    std::size_t block_size = size + align > m_block_size ? size + align : m_block_size;
+    m_blocks.push_back({new char[block_size], block_size});
+    return allocate(size, align);
+}
+
+void Arena::reset()
+{
+    m_current = 0;
+    m_offset = 0;
+    m_used_before = 0;
+}
+
+std::size_t Arena::used() const
+{
+    return m_used_before + m_offset;
+}
+
+unsigned Arena::blocksCount() const
+{
+    return m_blocks.size();
+}
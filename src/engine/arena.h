@@ -0,0 +1,86 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa przydziela pamięć przez przesuwanie wskaźnika w dużych blokach i zwalnia ją w całości jednym wywołaniem @a Arena::reset.
+ * Pojedynczych obiektów nie da się zwolnić, a ich destruktory nie są wywoływane, dlatego w arenie można umieszczać jedynie obiekty, które nie zarządzają żadnymi zasobami.
+ */
+class Arena
+{
+public:
+    /**
+     * Tworzenie areny; pierwszy blok jest przydzielany przy pierwszym żądaniu pamięci.
+     * @param block_size - rozmiar pojedynczego bloku w bajtach
+     */
+    Arena(std::size_t block_size = 64 * 1024);
+    ~Arena();
+
+    /**
+     * Przydział pamięci.
+     * @param size - liczba bajtów
+     * @param align - wymagane wyrównanie adresu; musi być potęgą dwójki
+     * @return wskaźnik na niezainicjalizowaną pamięć ważny do najbliższego wywołania @a Arena::reset
+     */
+    void* allocate(std::size_t size, std::size_t align);
+    /**
+     * Tworzenie obiektu w pamięci areny.
+     * @param args - argumenty konstruktora
+     * @return wskaźnik na nowy obiekt
+     */
+    template <class T, class... Args>
+    T* create(Args&&... args)
+    {
+        return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+    /**
+     * Unieważnienie całej przydzielonej pamięci. Bloki nie są zwalniane, tylko wykorzystywane ponownie przez kolejne przydziały.
+     */
+    void reset();
+    /**
+     * @return liczbę bajtów przydzielonych od ostatniego wywołania @a Arena::reset
+     */
+    std::size_t used() const;
+    /**
+     * @return liczbę bloków pobranych ze sterty
+     */
+    unsigned blocksCount() const;
+
+private:
+    /**
+     * @brief Blok pamięci areny.
+     */
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    /**
+     * Bloki pamięci w kolejności ich wykorzystywania.
+     */
+    std::vector<Block> m_blocks;
+    /**
+     * Domyślny rozmiar bloku.
+     */
+    std::size_t m_block_size;
+    /**
+     * Indeks aktualnie wypełnianego bloku.
+     */
+    unsigned m_current;
+    /**
+     * Liczba zajętych bajtów w aktualnym bloku.
+     */
+    std::size_t m_offset;
+    /**
+     * Liczba bajtów w całości zajętych poprzednich blokach.
+     */
+    std::size_t m_used_before;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,80 @@
+#include "assetpack.h"
+#include <cstring>
+
+AssetPack::AssetPack()
+{
+}
+
+bool AssetPack::open(const std::string& path)
+{
+    close();
+    if(!m_file.open(path)) return false;
+
+    const char* data = m_file.data();
+    std::size_t size = m_file.size();
+
+    //sprawdzenie, czy wszystkie części opisane w nagłówkach mieszczą się w pliku
+    Header header;
+    ImageHeader image;
+    std::size_t offset = sizeof(Header) + sizeof(ImageHeader);
+    bool valid = size >= offset;
+    if(valid)
+    {
+        std::memcpy(&header, data, sizeof(Header));
+        std::memcpy(&image, data + sizeof(Header), sizeof(ImageHeader));
+        valid = header.magic == magic && header.version == version
+                && static_cast<Uint64>(image.width) * image.height * 4 <= size - offset;
+    }
+    if(valid) offset += static_cast<std::size_t>(image.width) * image.height * 4;
+    for(unsigned i = 0; valid && i < header.fonts_count; i++)
+    {
+        FontHeader font;
+        valid = size - offset >= sizeof(FontHeader);
+        if(!valid) break;
+        std::memcpy(&font, data + offset, sizeof(FontHeader));
+        m_font_offsets.push_back(offset);
+        offset += sizeof(FontHeader) + glyphs_count * sizeof(Glyph);
+        valid = offset <= size && static_cast<Uint64>(font.sheet_width) * font.height <= size - offset;
+        if(valid) offset += static_cast<std::size_t>(font.sheet_width) * font.height;
+    }
+    if(!valid) close();
+    return valid;
+}
+
+void AssetPack::close()
+{
+    m_file.close();
+    m_font_offsets.clear();
+}
+
+bool AssetPack::isOpen() const
+{
+    return m_file.data() != nullptr;
+}
+
+const void* AssetPack::image(int& width, int& height) const
+{
+    if(!isOpen()) return nullptr;
+    ImageHeader image;
+    std::memcpy(&image, m_file.data() + sizeof(Header), sizeof(ImageHeader));
+    width = image.width;
+    height = image.height;
+    return m_file.data() + sizeof(Header) + sizeof(ImageHeader);
+}
+
+unsigned AssetPack::fontsCount() const
+{
+    return m_font_offsets.size();
+}
+
+bool AssetPack::font(unsigned index, Font& font) const
+{
+    if(index >= m_font_offsets.size()) return false;
+    const char* data = m_file.data() + m_font_offsets.at(index);
+    std::memcpy(&font.header, data, sizeof(FontHeader));
+    data += sizeof(FontHeader);
+    font.glyphs.resize(glyphs_count);
+    std::memcpy(font.glyphs.data(), data, glyphs_count * sizeof(Glyph));
+    font.alpha = reinterpret_cast<const Uint8*>(data + glyphs_count * sizeof(Glyph));
+    return true;
+}
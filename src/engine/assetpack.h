@@ -0,0 +1,155 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include "mappedfile.h"
+#include <SDL2/SDL_stdinc.h>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa udostępnia zasoby graficzne przygotowane podczas budowania programu narzędziem tools/assetbake:
+ * zdekodowaną teksturę obiektów i czcionki narysowane wcześniej w kilku rozmiarach jako arkusze znaków.
+ * Dzięki temu przy starcie programu nie trzeba dekodować pliku PNG ani rasteryzować czcionki TTF.
+ * Plik składa się z nagłówka @a AssetPack::Header, nagłówka tekstury @a AssetPack::ImageHeader i jej pikseli w formacie SDL_PIXELFORMAT_ABGR8888,
+ * a następnie dla każdej czcionki z nagłówka @a AssetPack::FontHeader, tablicy @a AssetPack::Glyph dla znaków od @a AssetPack::first_glyph
+ * oraz arkusza znaków zapisanego jako jeden bajt przezroczystości na piksel. Wszystkie liczby są zapisane w porządku little-endian.
+ */
+class AssetPack
+{
+public:
+    /**
+     * @brief Nagłówek pliku.
+     */
+    struct Header
+    {
+        /**
+         * Znacznik pliku; zawsze @a AssetPack::magic.
+         */
+        Uint32 magic;
+        /**
+         * Wersja formatu; zawsze @a AssetPack::version.
+         */
+        Uint32 version;
+        /**
+         * Liczba czcionek.
+         */
+        Uint32 fonts_count;
+        Uint32 reserved;
+    };
+    /**
+     * @brief Nagłówek tekstury.
+     */
+    struct ImageHeader
+    {
+        Uint32 width;
+        Uint32 height;
+    };
+    /**
+     * @brief Nagłówek czcionki.
+     */
+    struct FontHeader
+    {
+        /**
+         * Rozmiar czcionki, w którym została narysowana.
+         */
+        Uint32 point_size;
+        /**
+         * Wysokość wiersza tekstu i arkusza znaków.
+         */
+        Uint32 height;
+        /**
+         * Szerokość arkusza znaków.
+         */
+        Uint32 sheet_width;
+        Uint32 reserved;
+    };
+    /**
+     * @brief Położenie znaku w arkuszu znaków.
+     */
+    struct Glyph
+    {
+        /**
+         * Lewa krawędź znaku w arkuszu.
+         */
+        Uint16 x;
+        /**
+         * Szerokość znaku w arkuszu.
+         */
+        Uint16 width;
+        /**
+         * Przesunięcie do następnego znaku w tekście.
+         */
+        Uint16 advance;
+        Uint16 reserved;
+    };
+    /**
+     * @brief Czcionka odczytana z pliku.
+     */
+    struct Font
+    {
+        FontHeader header;
+        /**
+         * Znaki od @a AssetPack::first_glyph.
+         */
+        std::vector<Glyph> glyphs;
+        /**
+         * Arkusz znaków: header.sheet_width * header.height bajtów przezroczystości; ważny do zamknięcia pliku.
+         */
+        const Uint8* alpha;
+    };
+
+    static const Uint32 magic = 0x54534154; //"TAST"
+    static const Uint32 version = 1;
+    /**
+     * Pierwszy znak zapisany w arkuszach znaków (spacja).
+     */
+    static const int first_glyph = 32;
+    /**
+     * Liczba znaków zapisanych w arkuszach znaków (drukowalne znaki ASCII).
+     */
+    static const int glyphs_count = 95;
+
+    AssetPack();
+
+    /**
+     * Odwzorowanie pliku w pamięci i sprawdzenie zgodności jego rozmiaru z nagłówkami.
+     * @param path - ścieżka do pliku
+     * @return true jeśli plik nadaje się do użycia
+     */
+    bool open(const std::string& path);
+    /**
+     * Zwolnienie odwzorowania pliku.
+     */
+    void close();
+    /**
+     * @return true jeśli plik jest otwarty
+     */
+    bool isOpen() const;
+    /**
+     * Dostęp do tekstury obiektów.
+     * @param width - szerokość tekstury
+     * @param height - wysokość tekstury
+     * @return piksele tekstury w formacie SDL_PIXELFORMAT_ABGR8888 ważne do zamknięcia pliku
+     */
+    const void* image(int& width, int& height) const;
+    /**
+     * @return liczbę czcionek w pliku
+     */
+    unsigned fontsCount() const;
+    /**
+     * Odczytanie czcionki.
+     * @param index - numer czcionki
+     * @param font - czcionka
+     * @return true jeśli czcionka jest w pliku
+     */
+    bool font(unsigned index, Font& font) const;
+
+private:
+    MappedFile m_file;
+    /**
+     * Położenia nagłówków kolejnych czcionek liczone od początku pliku.
+     */
+    std::vector<std::size_t> m_font_offsets;
+};
+
+#endif // ASSETPACK_H
@@ -1,10 +1,16 @@
 #include "engine.h"
+#include "../appconfig.h"
+#include <cstring>
 
 
 Engine::Engine()
 {
     m_renderer = nullptr;
     m_sprite_config = nullptr;
+    m_thread_pool = nullptr;
+    m_frame_arena = nullptr;
+    m_level_pack = nullptr;
+    m_level_loader = nullptr;
 }
 
 Engine &Engine::getEngine()
@@ -13,34 +19,92 @@ Engine &Engine::getEngine()
     return engine;
 }
 
+/**
+ * Zapis liczby całkowitej od końca bufora.
+ * @param num - liczba całkowita
+ * @param end - wskaźnik za ostatnim znakiem bufora; bufor musi mieścić co najmniej 11 znaków
+ * @return wskaźnik na pierwszy znak liczby
+ */
+static char* writeInt(int num, char* end)
+{
+    //wartość bezwzględna w typie bez znaku, aby nie przepełnić się dla najmniejszej liczby int
+    unsigned value = num < 0 ? 0u - static_cast<unsigned>(num) : static_cast<unsigned>(num);
+    char* p = end;
+    do
+    {
+        *--p = '0' + value % 10;
+        value /= 10;
+    } while(value);
+    if(num < 0) *--p = '-';
+    return p;
+}
+
 std::string Engine::intToString(int num)
 {
-    if(num == 0) return "0";
+    char buf[12];
+    char* start = writeInt(num, buf + sizeof(buf));
+    return std::string(start, buf + sizeof(buf));
+}
 
-    std::string buf;
-    bool negative = false;
-    if(num < 0)
-    {
-        negative = true;
-        num = -num;
-    }
-    for(; num; num /= 10) buf = "0123456789abcdef"[num % 10] + buf;
-    if(negative) buf = "-" + buf;
-    return buf;
+const char* Engine::frameText(const char* prefix, int num)
+{
+    char digits[12];
+    char* start = writeInt(num, digits + sizeof(digits));
+    std::size_t digits_length = digits + sizeof(digits) - start;
+    std::size_t prefix_length = std::strlen(prefix);
+
+    char* text = static_cast<char*>(m_frame_arena->allocate(prefix_length + digits_length + 1, 1));
+    std::memcpy(text, prefix, prefix_length);
+    std::memcpy(text + prefix_length, start, digits_length);
+    text[prefix_length + digits_length] = '\0';
+    return text;
 }
 
 void Engine::initModules()
+{
+    createModules();
+    createThreadPool();
+    loadSpriteConfig();
+    openLevelPack();
+}
+
+void Engine::createModules()
 {
     m_renderer = new Renderer;
+    m_frame_arena = new Arena(4 * 1024);
+}
+
+void Engine::createThreadPool()
+{
+    m_thread_pool = new ThreadPool(AppConfig::worker_threads > 0 ? AppConfig::worker_threads : SDL_GetCPUCount());
+}
+
+void Engine::loadSpriteConfig()
+{
     m_sprite_config = new SpriteConfig;
 }
 
+void Engine::openLevelPack()
+{
+    m_level_pack = new LevelPack;
+    m_level_pack->open(AppConfig::level_pack_path);
+    m_level_loader = new LevelLoader(m_level_pack);
+}
+
 void Engine::destroyModules()
 {
     delete m_renderer;
     m_renderer = nullptr;
     delete m_sprite_config;
     m_sprite_config = nullptr;
+    delete m_thread_pool;
+    m_thread_pool = nullptr;
+    delete m_frame_arena;
+    m_frame_arena = nullptr;
+    delete m_level_loader; //wątek wczytujący korzysta z paczki, więc jest zamykany wcześniej
+    m_level_loader = nullptr;
+    delete m_level_pack;
+    m_level_pack = nullptr;
 }
 
 Renderer *Engine::getRenderer() const
@@ -52,3 +116,23 @@ SpriteConfig *Engine::getSpriteConfig() const
 {
     return m_sprite_config;
 }
+
+ThreadPool *Engine::getThreadPool() const
+{
+    return m_thread_pool;
+}
+
+Arena *Engine::getFrameArena() const
+{
+    return m_frame_arena;
+}
+
+LevelPack *Engine::getLevelPack() const
+{
+    return m_level_pack;
+}
+
+LevelLoader *Engine::getLevelLoader() const
+{
+    return m_level_loader;
+}
@@ -3,6 +3,10 @@
 
 #include "renderer.h"
 #include "spriteconfig.h"
+#include "threadpool.h"
+#include "arena.h"
+#include "levelpack.h"
+#include "levelloader.h"
 
 /**
  * @brief Klasa łączy elementy związane z działaniem programu.
@@ -23,9 +27,33 @@ public:
      */
     static std::string intToString(int num);
     /**
-     * Funkcja tworzy obiekty składowe silnika.
+     * Funkcja zapisuje tekst zakończony liczbą w pamięci areny klatki; nie korzysta ze sterty po rozgrzaniu areny.
+     * @param prefix - tekst poprzedzający liczbę
+     * @param num - liczba całkowita
+     * @return tekst zakończony zerem ważny do końca bieżącej klatki
+     * @see Engine::getFrameArena()
+     */
+    const char* frameText(const char* prefix, int num);
+    /**
+     * Funkcja tworzy obiekty składowe silnika; jest równoważna wywołaniu @a Engine::createModules, @a Engine::createThreadPool, @a Engine::loadSpriteConfig i @a Engine::openLevelPack.
      */
     void initModules();
+    /**
+     * Funkcja tworzy obiekty składowe silnika, których stworzenie nie wymaga wczytywania plików ani SDL: Renderer i arenę klatki.
+     */
+    void createModules();
+    /**
+     * Funkcja tworzy pulę wątków; wymaga wcześniejszego udanego wywołania SDL_Init, bo tworzy wątki SDL.
+     */
+    void createThreadPool();
+    /**
+     * Funkcja tworzy tablicę animacji; może być wykonywana w innym wątku równolegle z pozostałymi etapami uruchamiania.
+     */
+    void loadSpriteConfig();
+    /**
+     * Funkcja otwiera paczkę poziomów i tworzy obiekt wczytujący poziomy; może być wykonywana w innym wątku równolegle z pozostałymi etapami uruchamiania.
+     */
+    void openLevelPack();
     /**
      * Funkcja niszczy obiekty składowe silnika.
      */
@@ -39,9 +67,29 @@ public:
      * @return wsaźnik na obiekt SpriteConfig przechowujący informacjie o teksturach
      */
     SpriteConfig* getSpriteConfig() const;
+    /**
+     * @return wskaźnik na obiekt ThreadPool pozwalający rozdzielić obliczenia na wiele wątków
+     */
+    ThreadPool* getThreadPool() const;
+    /**
+     * @return wskaźnik na arenę krótkotrwałych danych (np. tekstów), czyszczoną na początku każdej klatki w pętli głównej programu
+     */
+    Arena* getFrameArena() const;
+    /**
+     * @return wskaźnik na paczkę poziomów; paczka jest zamknięta, jeśli nie udało się jej otworzyć
+     */
+    LevelPack* getLevelPack() const;
+    /**
+     * @return wskaźnik na obiekt LevelLoader wczytujący w tle kolejny poziom
+     */
+    LevelLoader* getLevelLoader() const;
 private:
     Renderer* m_renderer;
     SpriteConfig* m_sprite_config;
+    ThreadPool* m_thread_pool;
+    Arena* m_frame_arena;
+    LevelPack* m_level_pack;
+    LevelLoader* m_level_loader;
 };
 
 #endif // ENGINE_H
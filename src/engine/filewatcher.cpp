@@ -0,0 +1,94 @@
+#include "filewatcher.h"
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher()
+{
+    m_fd = -1;
+    m_watch = -1;
+    m_mtime = 0;
+    m_last_check = 0;
+}
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+#ifdef __linux__
+    if(m_fd >= 0) close(m_fd);
+#endif
+}
+
+bool FileWatcher::watch(const std::string& path)
+{
+    std::size_t slash = path.find_last_of("/\\");
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+    m_path = path;
+    m_name = slash == std::string::npos ? path : path.substr(slash + 1);
+    m_mtime = modificationTime(path);
+    m_last_check = SDL_GetTicks();
+
+#ifdef __linux__
+    if(m_fd < 0) m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(m_fd < 0) return false;
+    //obserwacja katalogu jest zachowywana przy zmianie pliku w tym samym katalogu
+    if(m_watch >= 0 && dir == m_dir) return true;
+    if(m_watch >= 0) inotify_rm_watch(m_fd, m_watch);
+    m_dir = dir;
+    m_watch = inotify_add_watch(m_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    return m_watch >= 0;
+#else
+    m_dir = dir;
+    return true;
+#endif
+}
+
+void FileWatcher::stop()
+{
+#ifdef __linux__
+    if(m_watch >= 0) inotify_rm_watch(m_fd, m_watch);
+#endif
+    m_watch = -1;
+    m_path.clear();
+    m_name.clear();
+    m_dir.clear();
+}
+
+bool FileWatcher::poll()
+{
+    if(m_path.empty()) return false;
+
+#ifdef __linux__
+    if(m_watch < 0) return false;
+    bool changed = false;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while((length = read(m_fd, buffer, sizeof(buffer))) > 0)
+    {
+        for(char* p = buffer; p < buffer + length; )
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+            if(event->len > 0 && m_name == event->name) changed = true;
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+#else
+    Uint32 now = SDL_GetTicks();
+    if(now - m_last_check < poll_interval) return false;
+    m_last_check = now;
+    std::time_t mtime = modificationTime(m_path);
+    if(mtime == m_mtime) return false;
+    m_mtime = mtime;
+    return true;
+#endif
+}
+
+std::time_t FileWatcher::modificationTime(const std::string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? info.st_mtime : 0;
+}
@@ -0,0 +1,78 @@
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <SDL2/SDL.h>
+#include <ctime>
+#include <string>
+
+/**
+ * @brief
+ * Klasa wykrywa zapisanie obserwowanego pliku bez blokowania pętli głównej.
+ * W systemie Linux korzysta z inotify i obserwuje katalog pliku, dzięki czemu wykrywa również zapis przez zamianę pliku (jak robi wiele edytorów);
+ * w pozostałych systemach co @a FileWatcher::poll_interval milisekund porównuje czas modyfikacji pliku.
+ */
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    /**
+     * Rozpoczęcie obserwowania pliku; poprzednio obserwowany plik przestaje być obserwowany.
+     * @param path - ścieżka do pliku
+     * @return true jeśli udało się rozpocząć obserwowanie
+     */
+    bool watch(const std::string& path);
+    /**
+     * Zakończenie obserwowania.
+     */
+    void stop();
+    /**
+     * Sprawdzenie, czy plik został zapisany od poprzedniego wywołania; funkcja nie czeka na zdarzenia.
+     * @return true jeśli plik został zapisany
+     */
+    bool poll();
+
+    /**
+     * Odstęp między sprawdzeniami czasu modyfikacji pliku w systemach bez inotify.
+     */
+    static const Uint32 poll_interval = 250;
+
+    /**
+     * @param path - ścieżka do pliku
+     * @return czas modyfikacji pliku lub 0, jeśli pliku nie ma
+     */
+    static std::time_t modificationTime(const std::string& path);
+
+private:
+    FileWatcher(const FileWatcher&);
+    FileWatcher& operator=(const FileWatcher&);
+
+    std::string m_path;
+    /**
+     * Nazwa pliku w obserwowanym katalogu.
+     */
+    std::string m_name;
+    /**
+     * Obserwowany katalog.
+     */
+    std::string m_dir;
+    /**
+     * Deskryptor inotify lub -1.
+     */
+    int m_fd;
+    /**
+     * Deskryptor obserwacji katalogu lub -1.
+     */
+    int m_watch;
+    /**
+     * Ostatnio odczytany czas modyfikacji pliku.
+     */
+    std::time_t m_mtime;
+    /**
+     * Chwila ostatniego sprawdzenia czasu modyfikacji.
+     */
+    Uint32 m_last_check;
+};
+
+#endif // FILEWATCHER_H
@@ -0,0 +1,212 @@
+#include "levelgenerator.h"
+#include "random.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+/**
+ * @return lewe górne pole orzełka; bez metadanych orzełek stoi w kolumnie 12 dwóch ostatnich wierszy, tak jak w @a LevelTemplate
+ */
+static SDL_Point eagleCell(const LevelData& data)
+{
+    return data.eagle.x >= 0 ? data.eagle : SDL_Point{12, data.rows_count - 2};
+}
+
+/**
+ * Zebranie lewych górnych pól położeń startowych wrogów i graczy; domyślne położenia z @a AppConfig są podane w pikselach.
+ */
+static void startCells(const LevelData& data, std::vector<SDL_Point>& cells)
+{
+    cells = data.enemy_spawns;
+    if(data.enemy_spawns.empty())
+        for(auto& point : AppConfig::enemy_starting_point)
+            cells.push_back({point.x / AppConfig::tile_rect.w, point.y / AppConfig::tile_rect.h});
+    cells.insert(cells.end(), data.player_starts.begin(), data.player_starts.end());
+    if(data.player_starts.empty())
+        for(auto& point : AppConfig::player_starting_point)
+            cells.push_back({point.x / AppConfig::tile_rect.w, point.y / AppConfig::tile_rect.h});
+}
+
+/**
+ * Zapełnienie mapy blokami 2x2 pola, z których murki i kamienie często zajmują tylko połowę; większość map jest symetryczna względem pionowej osi.
+ */
+static void fillMap(Random& random, LevelData& data)
+{
+    int rows = data.rows_count, columns = data.columns_count;
+    data.cells.assign(rows * columns, '.');
+    for(int y = 0; y < rows; y += 2)
+    {
+        for(int x = 0; x < columns; x += 2)
+        {
+            unsigned roll = random.below(100);
+            char cell;
+            if(roll < 40) continue;
+            else if(roll < 70) cell = '#';
+            else if(roll < 80) cell = '@';
+            else if(roll < 87) cell = '%';
+            else if(roll < 94) cell = '~';
+            else cell = '-';
+
+            //0-3: górna, dolna, lewa lub prawa połowa bloku, pozostałe wartości: cały blok
+            unsigned part = (cell == '#' || cell == '@') ? random.below(8) : 4;
+            for(int j = y; j < y + 2 && j < rows; j++)
+            {
+                for(int i = x; i < x + 2 && i < columns; i++)
+                {
+                    bool inside = part >= 4 || (part == 0 && j == y) || (part == 1 && j == y + 1) || (part == 2 && i == x) || (part == 3 && i == x + 1);
+                    if(inside) data.cells.at(j * columns + i) = cell;
+                }
+            }
+        }
+    }
+
+    if(random.below(4) != 0)
+    {
+        for(int j = 0; j < rows; j++)
+            for(int i = 0; i < columns / 2; i++)
+                data.cells.at(j * columns + columns - 1 - i) = data.cells.at(j * columns + i);
+    }
+}
+
+/**
+ * Zastąpienie wszystkich pól prostokąta podanym znakiem lub, gdy @a only_blocking jest ustawione, tylko kamieni i wody.
+ */
+static void setCells(LevelData& data, int x1, int y1, int x2, int y2, char cell, bool only_blocking)
+{
+    for(int j = std::max(y1, 0); j <= y2 && j < data.rows_count; j++)
+    {
+        for(int i = std::max(x1, 0); i <= x2 && i < data.columns_count; i++)
+        {
+            char& current = data.cells.at(j * data.columns_count + i);
+            if(!only_blocking || current == '@' || current == '~') current = cell;
+        }
+    }
+}
+
+/**
+ * Oczyszczenie położeń startowych, postawienie murka wokół orzełka i oczyszczenie miejsca orzełka.
+ */
+static void placeFixedCells(LevelData& data, const std::vector<SDL_Point>& starts)
+{
+    SDL_Point eagle = eagleCell(data);
+    setCells(data, eagle.x - 1, eagle.y - 1, eagle.x + 2, eagle.y + 2, '#', false);
+    setCells(data, eagle.x, eagle.y, eagle.x + 1, eagle.y + 1, '.', false);
+    for(auto& cell : starts) setCells(data, cell.x, cell.y, cell.x + 1, cell.y + 1, '.', false);
+}
+
+/**
+ * Wycięcie w kamieniach i wodzie korytarza szerokości czołgu: od położenia startowego pionowo do wierszy orzełka, a dalej poziomo do orzełka.
+ */
+static void carvePath(LevelData& data, const SDL_Point& start)
+{
+    SDL_Point eagle = eagleCell(data);
+    setCells(data, start.x, std::min(start.y, eagle.y), start.x + 1, std::max(start.y, eagle.y) + 1, '.', true);
+    setCells(data, std::min(start.x, eagle.x), eagle.y, std::max(start.x, eagle.x) + 1, eagle.y + 1, '.', true);
+}
+
+/**
+ * Wypełnienie mapy położeń czołgu zaczynające się przy orzełku.
+ * @param data - opis poziomu
+ * @param reached - dla każdego położenia lewego górnego pola czołgu (kolumny [0, columns_count - 1), wiersze [0, rows_count - 1)) informacja, czy czołg może z niego dojechać do orzełka
+ */
+static void floodFromEagle(const LevelData& data, std::vector<Uint8>& reached)
+{
+    int columns = data.columns_count, rows = data.rows_count;
+    int width = columns - 1, height = rows - 1;
+    reached.assign(std::max(width, 0) * std::max(height, 0), 0);
+    SDL_Point eagle = eagleCell(data);
+    if(eagle.x < 0 || eagle.y < 0 || eagle.x >= width || eagle.y >= height) return;
+
+    //miejsce orzełka jest zawsze puste, bo LevelTemplate czyści je z przeszkód
+    auto passable = [&](int i, int j)
+    {
+        char cell = data.cells.at(j * columns + i);
+        bool inside_eagle = i >= eagle.x && i < eagle.x + 2 && j >= eagle.y && j < eagle.y + 2;
+        return inside_eagle || (cell != '@' && cell != '~');
+    };
+    auto open = [&](int x, int y)
+    {
+        return passable(x, y) && passable(x + 1, y) && passable(x, y + 1) && passable(x + 1, y + 1);
+    };
+
+    std::vector<int> queue;
+    queue.reserve(reached.size());
+    queue.push_back(eagle.y * width + eagle.x);
+    reached.at(queue.front()) = 1;
+    for(std::size_t k = 0; k < queue.size(); k++)
+    {
+        int x = queue.at(k) % width, y = queue.at(k) / width;
+        const int dx[] = {1, -1, 0, 0};
+        const int dy[] = {0, 0, 1, -1};
+        for(int d = 0; d < 4; d++)
+        {
+            int nx = x + dx[d], ny = y + dy[d];
+            if(nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            Uint8& visited = reached.at(ny * width + nx);
+            if(visited || !open(nx, ny)) continue;
+            visited = 1;
+            queue.push_back(ny * width + nx);
+        }
+    }
+}
+
+/**
+ * @return true jeśli położenie startowe mieści się na mapie i zostało osiągnięte przez @a floodFromEagle
+ */
+static bool startReached(const LevelData& data, const std::vector<Uint8>& reached, const SDL_Point& start)
+{
+    int width = data.columns_count - 1;
+    if(start.x < 0 || start.y < 0 || start.x >= width || start.y >= data.rows_count - 1) return false;
+    return reached.at(start.y * width + start.x) != 0;
+}
+
+void LevelGenerator::generate(Uint32 seed, LevelData& data)
+{
+    data = LevelData();
+    data.rows_count = AppConfig::map_rect.h / AppConfig::tile_rect.h;
+    data.columns_count = AppConfig::map_rect.w / AppConfig::tile_rect.w;
+
+    Random random(seed);
+    std::vector<SDL_Point> starts;
+    startCells(data, starts);
+    std::vector<Uint8> reached;
+    for(unsigned attempt = 0; attempt < max_attempts; attempt++)
+    {
+        fillMap(random, data);
+        placeFixedCells(data, starts);
+        floodFromEagle(data, reached);
+        bool valid = true;
+        for(auto& start : starts) valid = valid && startReached(data, reached, start);
+        if(valid) return;
+    }
+
+    //ostatnia wylosowana mapa z korytarzami do położeń, z których nie ma drogi do orzełka
+    for(auto& start : starts)
+        if(!startReached(data, reached, start)) carvePath(data, start);
+}
+
+void LevelGenerator::generate(Uint32 seed, unsigned count, ThreadPool* pool, std::vector<LevelData>& levels)
+{
+    levels.assign(count, LevelData());
+    pool->parallelFor(count, [&](int index, unsigned)
+    {
+        generate(levelSeed(seed, index), levels.at(index));
+    });
+}
+
+Uint32 LevelGenerator::levelSeed(Uint32 seed, unsigned index)
+{
+    return Random::mix(seed ^ Random::mix(index + 0x9E3779B9u));
+}
+
+bool LevelGenerator::reachable(const LevelData& data)
+{
+    if(data.cells.size() != static_cast<std::size_t>(data.rows_count) * data.columns_count) return false;
+
+    std::vector<SDL_Point> starts;
+    startCells(data, starts);
+    std::vector<Uint8> reached;
+    floodFromEagle(data, reached);
+    for(auto& start : starts)
+        if(!startReached(data, reached, start)) return false;
+    return true;
+}
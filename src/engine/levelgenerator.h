@@ -0,0 +1,53 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include "levelpack.h"
+#include "threadpool.h"
+#include <SDL2/SDL_stdinc.h>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa tworzy losowe poziomy w formacie plików tekstowych poziomów (znaki '.', '#', '@', '%', '~', '-') bez zapisywania ich na dysk.
+ * Mapa ma rozmiar @a AppConfig::map_rect, orzełek stoi w domyślnym miejscu, a gracze i wrogowie zaczynają w @a AppConfig::player_starting_point i @a AppConfig::enemy_starting_point.
+ * Każdy utworzony poziom przechodzi sprawdzenie @a LevelGenerator::reachable. Poziom zależy wyłącznie od ziarna, więc ten sam numer ziarna zawsze daje tę samą mapę, niezależnie od liczby wątków.
+ */
+class LevelGenerator
+{
+public:
+    /**
+     * Liczba losowań mapy, po której niezaliczona mapa jest naprawiana wycięciem korytarzy zamiast losowania kolejnej.
+     */
+    static const unsigned max_attempts = 8;
+
+    /**
+     * Utworzenie jednego poziomu.
+     * @param seed - ziarno poziomu
+     * @param data - opis poziomu
+     */
+    static void generate(Uint32 seed, LevelData& data);
+    /**
+     * Utworzenie wielu poziomów równolegle. Poziom o indeksie i powstaje z ziarna @a LevelGenerator::levelSeed(seed, i).
+     * @param seed - ziarno całej serii
+     * @param count - liczba poziomów
+     * @param pool - pula wątków wykonujących pracę
+     * @param levels - wektor, do którego trafiają poziomy; jego poprzednia zawartość jest zastępowana
+     */
+    static void generate(Uint32 seed, unsigned count, ThreadPool* pool, std::vector<LevelData>& levels);
+    /**
+     * @param seed - ziarno serii
+     * @param index - numer poziomu w serii
+     * @return ziarno poziomu o podanym numerze
+     */
+    static Uint32 levelSeed(Uint32 seed, unsigned index);
+    /**
+     * Sprawdzenie metodą wypełniania, czy czołg z każdego położenia wrogów i graczy może dojechać do orzełka.
+     * Czołg zajmuje obszar 2x2 pola; murki są przejezdne, bo można je zestrzelić, a kamienie i woda zamykają drogę.
+     * Brak metadanych w opisie oznacza te same domyślne położenia, których używa @a LevelTemplate.
+     * @param data - opis poziomu
+     * @return true jeśli orzełek jest osiągalny ze wszystkich położeń startowych
+     */
+    static bool reachable(const LevelData& data);
+};
+
+#endif // LEVELGENERATOR_H
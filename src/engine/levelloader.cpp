@@ -0,0 +1,99 @@
+#include "levelloader.h"
+#include "engine.h"
+#include "filewatcher.h"
+#include "../appconfig.h"
+#include <utility>
+
+LevelLoader::LevelLoader(const LevelPack* pack)
+{
+    m_pack = pack;
+    m_thread = nullptr;
+    m_mutex = SDL_CreateMutex();
+    m_wake = SDL_CreateCond();
+    m_requested = -1;
+    m_loading = -1;
+    m_quit = false;
+    m_level = -1;
+    m_loaded = false;
+}
+
+LevelLoader::~LevelLoader()
+{
+    if(m_thread != nullptr)
+    {
+        //zamknięcie czeka jedynie na dokończenie bieżącego poziomu; oczekujące żądanie jest porzucane
+        SDL_LockMutex(m_mutex);
+        m_quit = true;
+        SDL_CondSignal(m_wake);
+        SDL_UnlockMutex(m_mutex);
+        SDL_WaitThread(m_thread, nullptr);
+    }
+    SDL_DestroyCond(m_wake);
+    SDL_DestroyMutex(m_mutex);
+}
+
+void LevelLoader::request(int level)
+{
+    if(m_thread == nullptr) m_thread = SDL_CreateThread(loaderMain, "level loader", this);
+    if(m_thread == nullptr) return; //bez wątku poziom zostanie wczytany przy odbiorze
+
+    SDL_LockMutex(m_mutex);
+    m_level = -1;
+    m_requested = (level == m_loading ? -1 : level);
+    SDL_CondSignal(m_wake);
+    SDL_UnlockMutex(m_mutex);
+}
+
+bool LevelLoader::take(int level, LevelData& data)
+{
+    SDL_LockMutex(m_mutex);
+    bool ready = m_level == level && m_loaded;
+    if(ready) std::swap(data, m_data);
+    if(m_level == level) m_level = -1;
+    //poziom wczyta teraz wywołujący, więc nie ma potrzeby wczytywać go jeszcze raz w tle
+    if(m_requested == level) m_requested = -1;
+    SDL_UnlockMutex(m_mutex);
+    return ready;
+}
+
+bool LevelLoader::load(int level, LevelData& data) const
+{
+    std::string path = AppConfig::levels_path + Engine::intToString(level);
+    //czasy modyfikacji porównujemy tylko przy edycji poziomów; bez niej paczka jest zawsze pierwszym źródłem
+    bool text_newer = AppConfig::level_hot_reload
+            && FileWatcher::modificationTime(path) > FileWatcher::modificationTime(AppConfig::level_pack_path);
+    if(level >= 0 && !text_newer && m_pack->level(level, data)) return true;
+    if(LevelPack::readText(path, data)) return true;
+    return level >= 0 && text_newer && m_pack->level(level, data);
+}
+
+int LevelLoader::loaderMain(void* data)
+{
+    LevelLoader* loader = static_cast<LevelLoader*>(data);
+    LevelData level_data;
+
+    SDL_LockMutex(loader->m_mutex);
+    while(true)
+    {
+        while(loader->m_requested < 0 && !loader->m_quit) SDL_CondWait(loader->m_wake, loader->m_mutex);
+        if(loader->m_quit) break;
+        int level = loader->m_requested;
+        loader->m_requested = -1;
+        loader->m_loading = level;
+        SDL_UnlockMutex(loader->m_mutex);
+
+        bool loaded = loader->load(level, level_data);
+
+        SDL_LockMutex(loader->m_mutex);
+        loader->m_loading = -1;
+        //wynik jest udostępniany tylko wtedy, gdy w międzyczasie nie zgłoszono innego poziomu
+        if(loader->m_requested < 0)
+        {
+            loader->m_level = level;
+            loader->m_loaded = loaded;
+            std::swap(loader->m_data, level_data);
+        }
+    }
+    SDL_UnlockMutex(loader->m_mutex);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef LEVELLOADER_H
+#define LEVELLOADER_H
+
+#include "levelpack.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa wczytuje opis poziomu w tle, na osobnym wątku, zanim poziom będzie potrzebny (np. podczas wyświetlania wyników rundy).
+ * Wątek wczytujący działa przez cały czas życia obiektu i czeka na żądania. Ani zgłoszenie żądania, ani odbiór poziomu funkcją @a LevelLoader::take nie czekają na wczytywanie;
+ * blokada jest zajmowana przez wątek wczytujący tylko na chwilę pobrania żądania i przekazania wyniku.
+ */
+class LevelLoader
+{
+public:
+    /**
+     * @param pack - paczka poziomów, z której wczytywane są poziomy; jeśli jest zamknięta, nie zawiera poziomu lub (przy @a AppConfig::level_hot_reload) plik tekstowy poziomu jest nowszy, poziom jest czytany z pliku tekstowego
+     */
+    LevelLoader(const LevelPack* pack);
+    ~LevelLoader();
+
+    /**
+     * Zgłoszenie wczytania poziomu w tle. Poprzednio przygotowany, a nieodebrany poziom jest porzucany.
+     * Trwające wczytywanie innego poziomu nie jest przerywane; nowe żądanie zastępuje poprzednie oczekujące i jest wykonywane zaraz po nim.
+     * @param level - numer poziomu
+     */
+    void request(int level);
+    /**
+     * Odebranie poziomu przygotowanego w tle.
+     * @param level - numer poziomu
+     * @param data - opis poziomu
+     * @return true jeśli poziom o podanym numerze był już gotowy; w przeciwnym wypadku należy go wczytać funkcją @a LevelLoader::load
+     */
+    bool take(int level, LevelData& data);
+    /**
+     * Wczytanie poziomu w bieżącym wątku: z paczki, a gdy jej brak lub nie zawiera poziomu - z pliku tekstowego.
+     * Przy @a AppConfig::level_hot_reload plik tekstowy zapisany później niż paczka ma pierwszeństwo, więc poziom zmieniony w edytorze jest wczytywany w nowej postaci także po ponownym uruchomieniu gry, zanim paczka zostanie przebudowana.
+     * @param level - numer poziomu
+     * @param data - opis poziomu
+     * @return true jeśli udało się wczytać poziom
+     */
+    bool load(int level, LevelData& data) const;
+
+private:
+    /**
+     * Funkcja wątku wczytującego: wczytuje kolejne zgłoszone poziomy aż do zamknięcia obiektu.
+     * @param data - wskaźnik na obiekt LevelLoader
+     * @return kod zakończenia wątku
+     */
+    static int loaderMain(void* data);
+
+    const LevelPack* m_pack;
+    /**
+     * Wątek wczytujący uruchamiany przy pierwszym żądaniu lub nullptr.
+     */
+    SDL_Thread* m_thread;
+    /**
+     * Blokada chroniąca wszystkie poniższe pola.
+     */
+    SDL_mutex* m_mutex;
+    /**
+     * Sygnał nowego żądania lub zamknięcia dla wątku wczytującego.
+     */
+    SDL_cond* m_wake;
+    /**
+     * Numer poziomu oczekującego na wczytanie lub -1.
+     */
+    int m_requested;
+    /**
+     * Numer poziomu wczytywanego w tej chwili lub -1.
+     */
+    int m_loading;
+    /**
+     * Zmienna ustawiana w destruktorze, aby zakończyć wątek wczytujący.
+     */
+    bool m_quit;
+    /**
+     * Numer gotowego do odbioru poziomu lub -1.
+     */
+    int m_level;
+    /**
+     * Wynik wczytywania poziomu @a m_level.
+     */
+    bool m_loaded;
+    LevelData m_data;
+};
+
+#endif // LEVELLOADER_H
@@ -0,0 +1,307 @@
+#include "levelpack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+LevelData::LevelData()
+{
+    rows_count = 0;
+    columns_count = 0;
+    eagle = {-1, -1};
+}
+
+/**
+ * Dopisanie liczby 16-bitowej w porządku little-endian.
+ */
+static void put16(std::vector<char>& record, int value)
+{
+    record.push_back(static_cast<char>(value & 0xFF));
+    record.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+/**
+ * Odczytanie liczby 16-bitowej zapisanej w porządku little-endian.
+ */
+static int get16(const char* data)
+{
+    return static_cast<unsigned char>(data[0]) | static_cast<unsigned char>(data[1]) << 8;
+}
+
+/**
+ * Dopisanie liczby 32-bitowej w porządku little-endian.
+ */
+static void put32(std::vector<char>& data, Uint32 value)
+{
+    put16(data, value & 0xFFFF);
+    put16(data, value >> 16);
+}
+
+/**
+ * Odczytanie liczby 32-bitowej zapisanej w porządku little-endian.
+ */
+static Uint32 get32(const char* data)
+{
+    return static_cast<Uint32>(get16(data)) | static_cast<Uint32>(get16(data + 2)) << 16;
+}
+
+LevelPack::LevelPack()
+{
+    m_data = nullptr;
+    m_size = 0;
+}
+
+LevelPack::~LevelPack()
+{
+    close();
+}
+
+bool LevelPack::open(const std::string& path)
+{
+    close();
+    if(!m_file.open(path)) return false;
+    m_data = m_file.data();
+    m_size = m_file.size();
+
+    //sprawdzenie nagłówka, tablicy poziomów i sumy kontrolnej
+    Header header;
+    bool valid = m_size >= header_size;
+    if(valid)
+    {
+        header = readHeader();
+        valid = header.magic == magic && header.version == version
+                && header.levels_count <= (m_size - header_size) / entry_size
+                && header.checksum == checksum(m_data + header_size, m_size - header_size);
+    }
+    for(unsigned i = 0; valid && i < header.levels_count; i++)
+    {
+        Entry entry = readEntry(i);
+        valid = entry.offset <= m_size && entry.size <= m_size - entry.offset;
+    }
+    if(!valid) close();
+    return valid;
+}
+
+void LevelPack::close()
+{
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool LevelPack::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+unsigned LevelPack::levelsCount() const
+{
+    if(m_data == nullptr) return 0;
+    return readHeader().levels_count;
+}
+
+bool LevelPack::level(unsigned index, LevelData& data) const
+{
+    if(index >= levelsCount()) return false;
+
+    Entry entry = readEntry(index);
+    return deserialize(m_data + entry.offset, entry.size, data);
+}
+
+LevelPack::Header LevelPack::readHeader() const
+{
+    Header header;
+    header.magic = get32(m_data);
+    header.version = get32(m_data + 4);
+    header.levels_count = get32(m_data + 8);
+    header.checksum = get32(m_data + 12);
+    return header;
+}
+
+LevelPack::Entry LevelPack::readEntry(unsigned index) const
+{
+    const char* data = m_data + header_size + index * entry_size;
+    Entry entry;
+    entry.offset = get32(data);
+    entry.size = get32(data + 4);
+    return entry;
+}
+
+/**
+ * Odczytanie położenia pola z wiersza metadanych.
+ * @param line - pozostała część wiersza
+ * @param point - kolumna (x) i wiersz (y) pola
+ * @return true jeśli udało się odczytać dwie nieujemne liczby
+ */
+static bool readPoint(std::istringstream& line, SDL_Point& point)
+{
+    return (line >> point.x >> point.y) && point.x >= 0 && point.y >= 0;
+}
+
+/**
+ * @return true jeśli obszar 2x2 pola zaczynający się w podanym polu mieści się na mapie
+ */
+static bool insideLevel(const SDL_Point& point, const LevelData& data)
+{
+    return point.x + 1 < data.columns_count && point.y + 1 < data.rows_count;
+}
+
+bool LevelPack::readText(const std::string& path, LevelData& data)
+{
+    std::fstream level(path, std::ios::in);
+    std::string line;
+    std::vector<std::string> lines;
+
+    if(!level.is_open()) return false;
+    while(!level.eof())
+    {
+        std::getline(level, line);
+        lines.push_back(line);
+    }
+
+    data = LevelData();
+    unsigned first_row = 0;
+    int size_columns = -1, size_rows = -1;
+    if(!lines.empty() && lines.at(0).compare(0, 7, "version") == 0)
+    {
+        //nagłówek wersji 2 zakończony wierszem "map"
+        bool map_found = false;
+        for(; first_row < lines.size() && !map_found; first_row++)
+        {
+            std::string header = lines.at(first_row);
+            if(!header.empty() && header.back() == '\r') header.pop_back();
+            std::istringstream words(header);
+            std::string key;
+            if(!(words >> key)) continue;
+
+            bool valid = true;
+            SDL_Point point;
+            if(key == "version")
+            {
+                int file_version;
+                valid = (words >> file_version) && file_version == 2;
+            }
+            else if(key == "size") valid = (words >> size_columns >> size_rows) && size_columns > 0 && size_rows > 0;
+            else if(key == "eagle") valid = readPoint(words, data.eagle);
+            else if(key == "player")
+            {
+                valid = readPoint(words, point);
+                data.player_starts.push_back(point);
+            }
+            else if(key == "spawn")
+            {
+                valid = readPoint(words, point);
+                data.enemy_spawns.push_back(point);
+            }
+            else if(key == "roster")
+            {
+                std::string enemy;
+                while(valid && words >> enemy)
+                {
+                    valid = enemy.size() >= 2 && enemy.size() <= 3 && enemy.at(0) >= 'A' && enemy.at(0) <= 'D'
+                            && enemy.at(1) >= '1' && enemy.at(1) <= '4' && (enemy.size() == 2 || enemy.at(2) == '+');
+                    if(valid) data.roster.push_back({enemy.at(0), static_cast<Uint8>(enemy.at(1) - '0'), enemy.size() == 3});
+                }
+            }
+            else if(key == "map") map_found = true;
+            else valid = false;
+
+            if(!valid) return false;
+        }
+        if(!map_found) return false;
+    }
+    //bez podanego rozmiaru końcowe puste wiersze (np. znak nowej linii dopisany przez edytor) nie należą do mapy
+    while(size_rows < 0 && lines.size() > first_row && lines.back().empty()) lines.pop_back();
+
+    data.rows_count = size_rows >= 0 ? size_rows : lines.size() - first_row;
+    data.columns_count = size_columns >= 0 ? size_columns : (lines.size() > first_row ? lines.at(first_row).size() : 0);
+    data.cells.assign(data.rows_count * data.columns_count, '.');
+    for(int j = 0; j < data.rows_count && first_row + j < lines.size(); j++)
+    {
+        const std::string& row = lines.at(first_row + j);
+        std::size_t length = std::min(row.size(), static_cast<std::size_t>(data.columns_count));
+        if(length) std::memcpy(&data.cells.at(j * data.columns_count), row.data(), length);
+    }
+
+    if(data.eagle.x >= 0 && !insideLevel(data.eagle, data)) return false;
+    for(auto& point : data.player_starts) if(!insideLevel(point, data)) return false;
+    for(auto& point : data.enemy_spawns) if(!insideLevel(point, data)) return false;
+    return true;
+}
+
+void LevelPack::serialize(const LevelData& data, std::vector<char>& record)
+{
+    put16(record, data.rows_count);
+    put16(record, data.columns_count);
+    put16(record, data.eagle.x >= 0 ? data.eagle.x : 0xFFFF);
+    put16(record, data.eagle.y >= 0 ? data.eagle.y : 0xFFFF);
+    put16(record, data.player_starts.size());
+    put16(record, data.enemy_spawns.size());
+    put16(record, data.roster.size());
+    for(auto& point : data.player_starts)
+    {
+        put16(record, point.x);
+        put16(record, point.y);
+    }
+    for(auto& point : data.enemy_spawns)
+    {
+        put16(record, point.x);
+        put16(record, point.y);
+    }
+    for(auto& enemy : data.roster)
+    {
+        record.push_back(enemy.type);
+        record.push_back(static_cast<char>(enemy.lives));
+        record.push_back(enemy.bonus ? 1 : 0);
+    }
+    record.insert(record.end(), data.cells.begin(), data.cells.end());
+}
+
+bool LevelPack::deserialize(const char* record, std::size_t size, LevelData& data)
+{
+    const std::size_t counts_size = 7 * 2;
+    if(size < counts_size) return false;
+
+    data = LevelData();
+    data.rows_count = get16(record);
+    data.columns_count = get16(record + 2);
+    int eagle_x = get16(record + 4), eagle_y = get16(record + 6);
+    if(eagle_x != 0xFFFF && eagle_y != 0xFFFF) data.eagle = {eagle_x, eagle_y};
+    std::size_t players_count = get16(record + 8);
+    std::size_t spawns_count = get16(record + 10);
+    std::size_t roster_count = get16(record + 12);
+    std::size_t cells_count = static_cast<std::size_t>(data.rows_count) * data.columns_count;
+    if(size != counts_size + (players_count + spawns_count) * 4 + roster_count * 3 + cells_count) return false;
+
+    const char* p = record + counts_size;
+    for(std::size_t i = 0; i < players_count; i++, p += 4) data.player_starts.push_back({get16(p), get16(p + 2)});
+    for(std::size_t i = 0; i < spawns_count; i++, p += 4) data.enemy_spawns.push_back({get16(p), get16(p + 2)});
+    for(std::size_t i = 0; i < roster_count; i++, p += 3) data.roster.push_back({p[0], static_cast<Uint8>(p[1]), p[2] != 0});
+    data.cells.assign(p, p + cells_count);
+    return true;
+}
+
+void LevelPack::serializeHeader(const Header& header, std::vector<char>& data)
+{
+    put32(data, header.magic);
+    put32(data, header.version);
+    put32(data, header.levels_count);
+    put32(data, header.checksum);
+}
+
+void LevelPack::serializeEntry(const Entry& entry, std::vector<char>& data)
+{
+    put32(data, entry.offset);
+    put32(data, entry.size);
+}
+
+Uint32 LevelPack::checksum(const char* data, std::size_t size)
+{
+    Uint32 hash = 2166136261u;
+    for(std::size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
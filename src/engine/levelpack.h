@@ -0,0 +1,218 @@
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include "mappedfile.h"
+#include <SDL2/SDL_rect.h>
+#include <SDL2/SDL_stdinc.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Opis poziomu wczytany z pliku tekstowego lub z paczki poziomów. Położenia są podawane w polach mapy (kolumna, wiersz).
+ * Brak metadanych (pusty wektor, orzełek w (-1, -1)) oznacza domyślne wartości gry.
+ */
+struct LevelData
+{
+    /**
+     * @brief Wróg z listy wrogów poziomu.
+     */
+    struct RosterEntry
+    {
+        /**
+         * Typ wroga: 'A', 'B', 'C' lub 'D'.
+         */
+        char type;
+        /**
+         * Poziom pancerza z przedziału [1, 4].
+         */
+        Uint8 lives;
+        /**
+         * Zmienna mówi czy wróg po trafieniu tworzy bonus.
+         */
+        bool bonus;
+    };
+
+    LevelData();
+
+    int rows_count;
+    int columns_count;
+    /**
+     * Pola poziomu zapisane wierszami po jednym znaku na pole.
+     */
+    std::vector<char> cells;
+    /**
+     * Lewe górne pole orzełka.
+     */
+    SDL_Point eagle;
+    /**
+     * Lewe górne pola położeń startowych kolejnych graczy.
+     */
+    std::vector<SDL_Point> player_starts;
+    /**
+     * Lewe górne pola, w których pojawiają się wrogowie.
+     */
+    std::vector<SDL_Point> enemy_spawns;
+    /**
+     * Wrogowie poziomu w kolejności pojawiania się.
+     */
+    std::vector<RosterEntry> roster;
+};
+
+/**
+ * @brief
+ * Klasa udostępnia poziomy zapisane w jednym pliku binarnym (paczce) odwzorowanym w pamięci.
+ * Paczka jest tworzona z plików tekstowych poziomów narzędziem tools/levelpack; pliki tekstowe pozostają źródłem poziomów.
+ * Plik składa się z nagłówka @a LevelPack::Header, tablicy @a LevelPack::Entry dla każdego poziomu oraz rekordów poziomów (@a LevelPack::serialize).
+ * Wszystkie liczby są zapisane w porządku little-endian niezależnie od systemu; nagłówek i tablica są zapisywane pole po polu, a nie jako struktury.
+ */
+class LevelPack
+{
+public:
+    /**
+     * @brief Nagłówek paczki.
+     */
+    struct Header
+    {
+        /**
+         * Znacznik pliku; zawsze @a LevelPack::magic.
+         */
+        Uint32 magic;
+        /**
+         * Wersja formatu; zawsze @a LevelPack::version.
+         */
+        Uint32 version;
+        /**
+         * Liczba poziomów w paczce.
+         */
+        Uint32 levels_count;
+        /**
+         * Suma kontrolna wszystkiego, co znajduje się w pliku za nagłówkiem.
+         * @see LevelPack::checksum
+         */
+        Uint32 checksum;
+    };
+    /**
+     * @brief Opis jednego poziomu w tablicy poziomów.
+     */
+    struct Entry
+    {
+        /**
+         * Położenie rekordu poziomu liczone od początku pliku.
+         */
+        Uint32 offset;
+        /**
+         * Rozmiar rekordu poziomu w bajtach.
+         */
+        Uint32 size;
+    };
+
+    static const Uint32 magic = 0x4B504C54; //"TLPK"
+    static const Uint32 version = 2;
+    /**
+     * Rozmiar zapisanego nagłówka i opisu jednego poziomu w bajtach.
+     */
+    static const std::size_t header_size = 16;
+    static const std::size_t entry_size = 8;
+
+    LevelPack();
+    ~LevelPack();
+
+    /**
+     * Odwzorowanie paczki w pamięci i sprawdzenie jej poprawności (znacznika, wersji, granic tablicy i sumy kontrolnej).
+     * @param path - ścieżka do pliku paczki
+     * @return true jeśli paczka nadaje się do użycia
+     */
+    bool open(const std::string& path);
+    /**
+     * Zwolnienie odwzorowania paczki.
+     */
+    void close();
+    /**
+     * @return true jeśli paczka jest otwarta
+     */
+    bool isOpen() const;
+    /**
+     * @return liczbę poziomów w otwartej paczce
+     */
+    unsigned levelsCount() const;
+    /**
+     * Odczytanie poziomu z paczki.
+     * @param index - numer poziomu
+     * @param data - opis poziomu
+     * @return true jeśli poziom jest w paczce, a jego rekord jest poprawny
+     */
+    bool level(unsigned index, LevelData& data) const;
+
+    /**
+     * Wczytanie tekstowego pliku poziomu.
+     * Plik w wersji 1 zawiera jedynie wiersze pól; liczba kolumn jest równa długości pierwszego wiersza, a końcowe puste wiersze są pomijane.
+     * Plik w wersji 2 zaczyna się wierszem "version 2", po którym następują wiersze metadanych "size kolumny wiersze", "eagle kolumna wiersz",
+     * "player kolumna wiersz", "spawn kolumna wiersz", "roster A1 B2 D4+ ..." (typ, pancerz i opcjonalny bonus), a po wierszu "map" wiersze pól.
+     * Krótsze wiersze pól są uzupełniane pustymi polami, a dłuższe przycinane.
+     * @param path - ścieżka do pliku poziomu
+     * @param data - opis poziomu
+     * @return true jeśli udało się otworzyć i zinterpretować plik
+     */
+    static bool readText(const std::string& path, LevelData& data);
+    /**
+     * Zapisanie poziomu jako rekordu paczki: liczby 16-bitowe (wiersze, kolumny, kolumna i wiersz orzełka, liczba położeń graczy, liczba położeń wrogów, długość listy wrogów),
+     * położenia graczy i wrogów jako pary liczb 16-bitowych, lista wrogów po trzy bajty (typ, pancerz, bonus), a na końcu pola poziomu.
+     * @param data - opis poziomu
+     * @param record - bufor, na którego koniec dopisywany jest rekord
+     */
+    static void serialize(const LevelData& data, std::vector<char>& record);
+    /**
+     * Odczytanie rekordu zapisanego przez @a LevelPack::serialize.
+     * @param record - początek rekordu
+     * @param size - rozmiar rekordu w bajtach
+     * @param data - opis poziomu
+     * @return true jeśli rekord jest poprawny
+     */
+    static bool deserialize(const char* record, std::size_t size, LevelData& data);
+    /**
+     * Zapisanie nagłówka jako czterech liczb 32-bitowych w kolejności pól.
+     * @param header - nagłówek
+     * @param data - bufor, na którego koniec dopisywany jest nagłówek
+     */
+    static void serializeHeader(const Header& header, std::vector<char>& data);
+    /**
+     * Zapisanie opisu poziomu jako dwóch liczb 32-bitowych w kolejności pól.
+     * @param entry - opis poziomu
+     * @param data - bufor, na którego koniec dopisywany jest opis
+     */
+    static void serializeEntry(const Entry& entry, std::vector<char>& data);
+    /**
+     * Suma kontrolna FNV-1a.
+     * @param data - dane
+     * @param size - liczba bajtów
+     * @return 32-bitowa suma kontrolna
+     */
+    static Uint32 checksum(const char* data, std::size_t size);
+
+private:
+    /**
+     * Odczytanie nagłówka zapisanego przez @a LevelPack::serializeHeader z początku odwzorowanego pliku.
+     */
+    Header readHeader() const;
+    /**
+     * Odczytanie opisu poziomu zapisanego przez @a LevelPack::serializeEntry z tablicy poziomów.
+     * @param index - numer poziomu
+     */
+    Entry readEntry(unsigned index) const;
+
+    /**
+     * Plik paczki odwzorowany w pamięci.
+     */
+    MappedFile m_file;
+    /**
+     * Początek odwzorowanego pliku.
+     */
+    const char* m_data;
+    /**
+     * Rozmiar odwzorowanego pliku.
+     */
+    std::size_t m_size;
+};
+
+#endif // LEVELPACK_H
@@ -0,0 +1,55 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief
+ * Plik odwzorowany w pamięci tylko do odczytu (mmap w systemach POSIX, MapViewOfFile w Windows).
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+     * Odwzorowanie pliku w pamięci; poprzednio odwzorowany plik jest zwalniany.
+     * @param path - ścieżka do pliku
+     * @return true jeśli plik istnieje, nie jest pusty i udało się go odwzorować
+     */
+    bool open(const std::string& path);
+    /**
+     * Zwolnienie odwzorowania.
+     */
+    void close();
+    /**
+     * @return początek odwzorowanego pliku lub nullptr
+     */
+    const char* data() const;
+    /**
+     * @return rozmiar odwzorowanego pliku w bajtach
+     */
+    std::size_t size() const;
+
+    /**
+     * Zastąpienie pliku zapisanym obok plikiem tymczasowym przez zmianę nazwy.
+     * Gra odwzorowuje pliki zasobów na cały czas działania, a nadpisanie takiego pliku w miejscu (np. przy przebudowie podczas edycji poziomów) zmieniłoby dane pod odwzorowaniem,
+     * a po skróceniu pliku odczyt kończyłby się sygnałem SIGBUS. Odwzorowanie starego pliku pozostaje ważne po zmianie nazwy.
+     * W systemie Windows zastąpienie pliku odwzorowanego przez inny proces się nie udaje i plik pozostaje bez zmian.
+     * @param temp_path - ścieżka do zapisanego pliku tymczasowego; plik jest usuwany, jeśli nie uda się go przenieść
+     * @param path - ścieżka do zastępowanego pliku
+     * @return true jeśli plik został zastąpiony
+     */
+    static bool replace(const std::string& temp_path, const std::string& path);
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* m_data;
+    std::size_t m_size;
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,90 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief
+ * Szablon puli pamięci o stałej pojemności dla obiektów jednego typu.
+ * Pamięć na wszystkie obiekty jest rezerwowana raz, a zwolnione miejsca trafiają na listę wolnych miejsc, dzięki czemu tworzenie i usuwanie obiektów w czasie gry nie odwołuje się do sterty.
+ * Pula jest przeznaczona do wykorzystania w przeciążonych operatorach new i delete klasy. Po wyczerpaniu miejsc pamięć jest przydzielana ze sterty.
+ * Pula nie jest bezpieczna wielowątkowo; obiekty są tworzone i usuwane jedynie w wątku głównym.
+ * @tparam T - typ przechowywanych obiektów
+ * @tparam N - liczba miejsc w puli
+ */
+template <class T, unsigned N>
+class ObjectPool
+{
+public:
+    ObjectPool()
+    {
+        for(unsigned i = 0; i < N; i++) m_next[i] = i + 1;
+        m_free = 0;
+        m_heap_allocations = 0;
+    }
+
+    /**
+     * Przydzielenie pamięci na jeden obiekt.
+     * @param size - rozmiar obiektu; rozmiar różny od rozmiaru typu @a T (np. klasa pochodna) powoduje przydział ze sterty
+     * @return wskaźnik na niezainicjalizowaną pamięć
+     */
+    void* allocate(std::size_t size)
+    {
+        if(size != sizeof(T) || m_free >= N)
+        {
+            m_heap_allocations++;
+            return ::operator new(size);
+        }
+        unsigned index = m_free;
+        m_free = m_next[index];
+        return &m_storage[index];
+    }
+    /**
+     * Zwolnienie pamięci obiektu. Pamięć spoza puli jest oddawana na stertę.
+     * @param ptr - wskaźnik zwrócony przez @a ObjectPool::allocate
+     */
+    void deallocate(void* ptr)
+    {
+        if(ptr == nullptr) return;
+        Storage* slot = static_cast<Storage*>(ptr);
+        if(slot < m_storage || slot >= m_storage + N)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        unsigned index = slot - m_storage;
+        m_next[index] = m_free;
+        m_free = index;
+    }
+    /**
+     * @return liczbę przydziałów, które z powodu braku miejsc w puli trafiły na stertę
+     */
+    unsigned heapAllocations() const
+    {
+        return m_heap_allocations;
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+    /**
+     * Pamięć na obiekty.
+     */
+    Storage m_storage[N];
+    /**
+     * Dla wolnego miejsca indeks następnego wolnego miejsca; wartość N oznacza koniec listy.
+     */
+    unsigned m_next[N];
+    /**
+     * Indeks pierwszego wolnego miejsca; wartość N oznacza brak wolnych miejsc.
+     */
+    unsigned m_free;
+    /**
+     * Licznik przydziałów ze sterty.
+     */
+    unsigned m_heap_allocations;
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,64 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL2/SDL_stdinc.h>
+
+/**
+ * @brief
+ * Generator liczb pseudolosowych xorshift32. W przeciwieństwie do rand() ma własny stan, więc wiele obiektów może losować równocześnie w różnych wątkach,
+ * a ciąg liczb zależy tylko od ziarna, a nie od biblioteki standardowej ani od kolejności losowań innych obiektów.
+ */
+class Random
+{
+public:
+    /**
+     * @param seed - ziarno; różne ziarna dają różne ciągi liczb, również ziarna różniące się jednym bitem
+     */
+    Random(Uint32 seed = 0)
+    {
+        m_state = mix(seed) | 1;
+    }
+
+    /**
+     * @return kolejną liczbę pseudolosową
+     */
+    Uint32 next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+    /**
+     * @return liczbę z przedziału [0, count)
+     */
+    unsigned below(unsigned count)
+    {
+        return next() % count;
+    }
+    /**
+     * @return liczbę z przedziału [0, 1]
+     */
+    float unit()
+    {
+        return static_cast<float>(next()) / 0xFFFFFFFFu;
+    }
+
+    /**
+     * Wymieszanie bitów liczby (krok końcowy funkcji MurmurHash3).
+     */
+    static Uint32 mix(Uint32 value)
+    {
+        value ^= value >> 16;
+        value *= 0x85EBCA6Bu;
+        value ^= value >> 13;
+        value *= 0xC2B2AE35u;
+        value ^= value >> 16;
+        return value;
+    }
+
+private:
+    Uint32 m_state;
+};
+
+#endif // RANDOM_H
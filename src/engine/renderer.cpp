@@ -1,16 +1,31 @@
 #include "renderer.h"
 #include "../appconfig.h"
+#include "alloctracker.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <iostream>
 
+/**
+ * Rozmiary czcionek o numerach 1, 2 i 3.
+ */
+static const int font_sizes[3] = {28, 14, 10};
+
 Renderer::Renderer()
 {
     m_texture = nullptr;
     m_renderer = nullptr;
     m_text_texture = nullptr;
+    m_texture_surface = nullptr;
     m_font1 = nullptr;
     m_font2 = nullptr;
+    m_font3 = nullptr;
+    for(auto& font : m_baked_fonts)
+    {
+        font.texture = nullptr;
+        font.width = 0;
+        font.height = 0;
+    }
+    m_fonts_baked = false;
 }
 
 Renderer::~Renderer()
@@ -21,33 +36,117 @@ Renderer::~Renderer()
         SDL_DestroyTexture(m_texture);
     if(m_text_texture != nullptr)
         SDL_DestroyTexture(m_text_texture);
+    if(m_texture_surface != nullptr)
+        SDL_FreeSurface(m_texture_surface);
     if(m_font1 != nullptr)
         TTF_CloseFont(m_font1);
     if(m_font2 != nullptr)
         TTF_CloseFont(m_font2);
     if(m_font3 != nullptr)
         TTF_CloseFont(m_font3);
+    for(auto& font : m_baked_fonts)
+        if(font.texture != nullptr)
+            SDL_DestroyTexture(font.texture);
 }
 
-void Renderer::loadTexture(SDL_Window* window)
+bool Renderer::openAssets()
+{
+    return m_assets.isOpen() || m_assets.open(AppConfig::assets_path);
+}
+
+void Renderer::createRenderer(SDL_Window* window)
 {
-    SDL_Surface* surface = nullptr;
     m_renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+}
+
+void Renderer::prepareTexture()
+{
+    //tekstura zdekodowana podczas budowania programu nie wymaga przygotowania
+    int width, height;
+    const void* pixels = m_assets.isOpen() ? m_assets.image(width, height) : nullptr;
+    if(pixels == nullptr)
+    {
+        if(!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return;
+        m_texture_surface = IMG_Load(AppConfig::texture_path.c_str());
+        if(m_texture_surface == nullptr) return;
+
+        //do złożenia z obrazkami z katalogu sprite'ów potrzebne są piksele w jednym formacie
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(m_texture_surface, SDL_PIXELFORMAT_ABGR8888, 0);
+        if(surface == nullptr) return;
+        SDL_FreeSurface(m_texture_surface);
+        m_texture_surface = surface;
+        pixels = surface->pixels;
+        width = surface->w;
+        height = surface->h;
+    }
+    m_sprite_atlas.build(static_cast<const Uint32*>(pixels), width, height, AppConfig::sprites_path, AppConfig::sprite_cache_path);
+}
+
+void Renderer::prepareFont()
+{
+    //arkusze znaków narysowane podczas budowania programu
+    m_fonts_baked = m_assets.isOpen() && m_assets.fontsCount() >= 3;
+    for(int i = 0; i < 3 && m_fonts_baked; i++)
+    {
+        AssetPack::Font font;
+        m_fonts_baked = m_assets.font(i, font) && static_cast<int>(font.header.point_size) == font_sizes[i];
+        if(!m_fonts_baked) break;
+
+        BakedFont& baked = m_baked_fonts[i];
+        baked.width = font.header.sheet_width;
+        baked.height = font.header.height;
+        baked.glyphs = font.glyphs;
+        baked.pixels.resize(static_cast<std::size_t>(baked.width) * baked.height);
+        for(std::size_t p = 0; p < baked.pixels.size(); p++)
+            baked.pixels[p] = static_cast<Uint32>(font.alpha[p]) << 24 | 0xFFFFFF;
+    }
+    if(!m_fonts_baked) openFonts();
+}
 
-    surface = IMG_Load(AppConfig::texture_path.c_str());
+void Renderer::uploadTextures()
+{
+    if(m_renderer != nullptr)
+    {
+        int width = m_sprite_atlas.width(), height = m_sprite_atlas.height();
+        const void* pixels = m_sprite_atlas.pixels();
+        if(pixels == nullptr && m_assets.isOpen()) pixels = m_assets.image(width, height);
+        if(pixels != nullptr)
+        {
+            m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STATIC, width, height);
+            if(m_texture != nullptr && SDL_UpdateTexture(m_texture, NULL, pixels, width * 4) == 0)
+                SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+        }
+        else if(m_texture_surface != nullptr)
+            m_texture = SDL_CreateTextureFromSurface(m_renderer, m_texture_surface);
 
-    //load surface
-    if(surface != nullptr && m_renderer != nullptr)
-        m_texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+        for(int i = 0; i < 3 && m_fonts_baked; i++)
+        {
+            BakedFont& baked = m_baked_fonts[i];
+            baked.texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STATIC, baked.width, baked.height);
+            m_fonts_baked = baked.texture != nullptr && SDL_UpdateTexture(baked.texture, NULL, baked.pixels.data(), baked.width * 4) == 0;
+            if(m_fonts_baked) SDL_SetTextureBlendMode(baked.texture, SDL_BLENDMODE_BLEND);
+            std::vector<Uint32>().swap(baked.pixels);
+        }
+        if(!m_fonts_baked && m_font1 == nullptr) openFonts();
+    }
 
-    SDL_FreeSurface(surface);
+    SDL_FreeSurface(m_texture_surface);
+    m_texture_surface = nullptr;
+    m_sprite_atlas.releasePixels();
+    m_assets.close(); //wszystkie zasoby są już w teksturach
 }
 
-void Renderer::loadFont()
+const SpriteAtlas* Renderer::getSpriteAtlas() const
 {
-    m_font1 = TTF_OpenFont(AppConfig::font_name.c_str(), 28);
-    m_font2 = TTF_OpenFont(AppConfig::font_name.c_str(), 14);
-    m_font3 = TTF_OpenFont(AppConfig::font_name.c_str(), 10);
+    return &m_sprite_atlas;
+}
+
+void Renderer::openFonts()
+{
+    if(!TTF_WasInit() && TTF_Init() == -1) return;
+    m_font1 = TTF_OpenFont(AppConfig::font_name.c_str(), font_sizes[0]);
+    m_font2 = TTF_OpenFont(AppConfig::font_name.c_str(), font_sizes[1]);
+    m_font3 = TTF_OpenFont(AppConfig::font_name.c_str(), font_sizes[2]);
 }
 
 void Renderer::clear()
@@ -83,16 +182,22 @@ void Renderer::setScale(float xs, float ys)
     SDL_RenderSetViewport(m_renderer, &viewport);
 }
 
-void Renderer::drawText(const SDL_Point* start, string text, SDL_Color text_color, int font_size)
+void Renderer::drawText(const SDL_Point* start, const char* text, SDL_Color text_color, int font_size)
 {
+    if(m_fonts_baked)
+    {
+        drawBakedText(start, text, text_color, m_baked_fonts[font_size == 2 ? 1 : font_size == 3 ? 2 : 0]);
+        return;
+    }
     if(m_font1 == nullptr || m_font2 == nullptr || m_font3 == nullptr) return;
+    AllocPhaseScope phase(AP_DRAW_TEXT);
     if(m_text_texture != nullptr)
         SDL_DestroyTexture(m_text_texture);
 
     SDL_Surface* text_surface = nullptr;
-    if(font_size == 2) text_surface = TTF_RenderText_Solid(m_font2, text.c_str(), text_color);
-    else if(font_size == 3) text_surface = TTF_RenderText_Solid(m_font3, text.c_str(), text_color);
-    else text_surface = TTF_RenderText_Solid(m_font1, text.c_str(), text_color);
+    if(font_size == 2) text_surface = TTF_RenderText_Solid(m_font2, text, text_color);
+    else if(font_size == 3) text_surface = TTF_RenderText_Solid(m_font3, text, text_color);
+    else text_surface = TTF_RenderText_Solid(m_font1, text, text_color);
 
     if(text_surface == nullptr) return;
 
@@ -119,6 +224,38 @@ void Renderer::drawText(const SDL_Point* start, string text, SDL_Color text_colo
     SDL_RenderCopy(m_renderer, m_text_texture, NULL, &window_dest);
 }
 
+void Renderer::drawBakedText(const SDL_Point* start, const char* text, SDL_Color text_color, const BakedFont& font)
+{
+    //znaki spoza arkusza są rysowane jako '?'
+    auto glyph = [&font](char c) -> const AssetPack::Glyph& {
+        int index = static_cast<unsigned char>(c) - AssetPack::first_glyph;
+        if(index < 0 || index >= AssetPack::glyphs_count) index = '?' - AssetPack::first_glyph;
+        return font.glyphs[index];
+    };
+
+    int width = 0;
+    for(const char* c = text; *c != '\0'; c++) width += glyph(*c).advance;
+
+    SDL_Point pen;
+    if(start == nullptr || start->x < 0) pen.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - width)/2;
+    else pen.x = start->x;
+    if(start == nullptr || start->y < 0) pen.y = (AppConfig::map_rect.h - font.height)/2;
+    else pen.y = start->y;
+
+    SDL_SetTextureColorMod(font.texture, text_color.r, text_color.g, text_color.b);
+    for(const char* c = text; *c != '\0'; c++)
+    {
+        const AssetPack::Glyph& g = glyph(*c);
+        if(g.width > 0)
+        {
+            SDL_Rect texture_src = {g.x, 0, g.width, font.height};
+            SDL_Rect window_dest = {pen.x, pen.y, g.width, font.height};
+            SDL_RenderCopy(m_renderer, font.texture, &texture_src, &window_dest);
+        }
+        pen.x += g.advance;
+    }
+}
+
 void Renderer::drawRect(const SDL_Rect *rect, SDL_Color rect_color, bool fill)
 {
     SDL_SetRenderDrawColor(m_renderer, rect_color.r, rect_color.g, rect_color.b, rect_color.a);
@@ -1,9 +1,12 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "assetpack.h"
+#include "spriteatlas.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <string>
+#include <vector>
 
 /**
  * @brief
@@ -15,14 +18,35 @@ public:
     Renderer();
     ~Renderer();
     /**
-     * Wczytanie tekstury z pliku oraz stworzenie renderera związanego z oknem aplikacji.
+     * Otwarcie pliku zasobów @a AppConfig::assets_path; wywoływane w wątku głównym przed @a Renderer::prepareTexture i @a Renderer::prepareFont.
+     * @return true jeśli plik zasobów jest dostępny
+     */
+    bool openAssets();
+    /**
+     * Stworzenie renderera związanego z oknem aplikacji; wywoływane w wątku głównym.
      * @param window - wskaźnik na obiekt zawartości okna aplikacji
      */
-    void loadTexture(SDL_Window* window);
+    void createRenderer(SDL_Window* window);
+    /**
+     * Przygotowanie tekstury obiektów: jeśli nie ma pliku zasobów, tekstura jest dekodowana z pliku @a AppConfig::texture_path.
+     * Jeśli istnieje katalog @a AppConfig::sprites_path, jego obrazki są dokładane do tekstury (@a SpriteAtlas).
+     * Nie korzysta z renderera, więc może być wykonywane w innym wątku równolegle z @a Renderer::prepareFont i tworzeniem okna.
+     */
+    void prepareTexture();
     /**
-     * Wczytwanie czcionki w trzech różnych rozmiarach.
+     * Przygotowanie czcionki w trzech różnych rozmiarach: arkuszy znaków z pliku zasobów, a jeśli ich nie ma, czcionki z pliku @a AppConfig::font_name.
+     * Nie korzysta z renderera, więc może być wykonywane w innym wątku równolegle z @a Renderer::prepareTexture i tworzeniem okna.
      */
-    void loadFont();
+    void prepareFont();
+    /**
+     * Stworzenie tekstur z danych przygotowanych przez @a Renderer::prepareTexture i @a Renderer::prepareFont oraz zamknięcie pliku zasobów;
+     * wywoływane w wątku głównym po stworzeniu renderera i zakończeniu przygotowań.
+     */
+    void uploadTextures();
+    /**
+     * @return wskaźnik na obiekt z położeniami obrazków z katalogu sprite'ów w teksturze obiektów
+     */
+    const SpriteAtlas* getSpriteAtlas() const;
     /**
      * Czyszczenie bufora ekranu.
      */
@@ -47,11 +71,12 @@ public:
     /**
      * Rysowanie tekstu w buforze okna w wybranej pozycji początkowej.
      * @param start - położenie punktu początkowego rysowanego tekstu; ujemna wartości którejś ze wspołrzędnych skutkuje wyśrodkowaniem napisu w tej osi
-     * @param text - rysowany tekst
+     * @param text - rysowany tekst zakończony zerem; nie jest kopiowany, więc może leżeć w arenie klatki
      * @param text_color - kolory rysowanego tekst
      * @param font_size - numer czcionki za pomocą, której będzi rysoweny tekst; dostępne trzy wartośc: 1, 2, 3
+     * @see Engine::frameText(const char* prefix, int num)
      */
-    void drawText(const SDL_Point* start, std::string text, SDL_Color text_color, int font_size = 1);
+    void drawText(const SDL_Point* start, const char* text, SDL_Color text_color, int font_size = 1);
     /**
      * Funkcja rysująca prostokątk w buforze okna.
      * @param rect - położneie prostokątku na planszy
@@ -61,6 +86,43 @@ public:
     void drawRect(const SDL_Rect* rect, SDL_Color rect_color, bool fill = false);
 
 private:
+    /**
+     * @brief Czcionka narysowana wcześniej jako arkusz znaków.
+     */
+    struct BakedFont
+    {
+        /**
+         * Arkusz znaków jako biała tekstura z przezroczystością; kolor tekstu jest nadawany przez SDL_SetTextureColorMod.
+         */
+        SDL_Texture* texture;
+        /**
+         * Szerokość arkusza znaków.
+         */
+        int width;
+        /**
+         * Wysokość wiersza tekstu.
+         */
+        int height;
+        /**
+         * Znaki od @a AssetPack::first_glyph.
+         */
+        std::vector<AssetPack::Glyph> glyphs;
+        /**
+         * Piksele arkusza znaków przygotowane do stworzenia tekstury; zwalniane po jej stworzeniu.
+         */
+        std::vector<Uint32> pixels;
+    };
+
+    /**
+     * Otwarcie czcionki TTF w trzech rozmiarach, gdy nie ma arkuszy znaków.
+     */
+    void openFonts();
+    /**
+     * Rysowanie tekstu znak po znaku z arkusza znaków.
+     * @see Renderer::drawText
+     */
+    void drawBakedText(const SDL_Point* start, const char* text, SDL_Color text_color, const BakedFont& font);
+
     /**
      * Wskaźnik na obiekt związany z buforem okna.
      */
@@ -73,6 +135,10 @@ private:
      * Wskaźnik na teksturę pomocniczą przy rysowaniu tekstu na ekranie.
      */
     SDL_Texture* m_text_texture;
+    /**
+     * Tekstura zdekodowana z pliku PNG czekająca na @a Renderer::uploadTextures.
+     */
+    SDL_Surface* m_texture_surface;
     /**
      * Czcionka o rozmiarze 28.
      */
@@ -85,6 +151,22 @@ private:
      * Czcionka o rozmiarze 10.
      */
     TTF_Font* m_font3;
+    /**
+     * Czcionki w rozmiarach 28, 14 i 10 z pliku zasobów; używane zamiast czcionek TTF, jeśli udało się je wczytać.
+     */
+    BakedFont m_baked_fonts[3];
+    /**
+     * Zmienna mówi czy tekst jest rysowany z arkuszy znaków.
+     */
+    bool m_fonts_baked;
+    /**
+     * Plik zasobów przygotowany podczas budowania programu.
+     */
+    AssetPack m_assets;
+    /**
+     * Tekstura obiektów złożona z obrazkami z katalogu sprite'ów.
+     */
+    SpriteAtlas m_sprite_atlas;
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,199 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Szablon kontenera przechowującego elementy w ciągłej tablicy i nadającego im stałe 32-bitowe uchwyty.
+ * Uchwyt składa się z numeru miejsca (młodsze 16 bitów) oraz generacji miejsca (starsze 16 bitów); po usunięciu elementu generacja miejsca rośnie, więc stare uchwyty przestają być ważne.
+ * Wstawianie, usuwanie i odszukanie elementu po uchwycie mają stały koszt. Usunięcie przenosi ostatni element na miejsce usuniętego, więc kolejność elementów w tablicy może się zmienić.
+ * @tparam T - typ przechowywanych elementów
+ */
+template <class T>
+class SlotMap
+{
+public:
+    typedef Uint32 Handle;
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * Uchwyt, który nigdy nie wskazuje na element.
+     */
+    static const Handle null_handle = 0;
+
+    SlotMap()
+    {
+        m_free = no_slot;
+    }
+
+    /**
+     * Dodanie elementu na koniec tablicy.
+     * @param value - nowy element
+     * @return uchwyt elementu lub @a null_handle, jeśli wszystkie 65535 miejsc jest zajętych
+     */
+    Handle insert(const T& value)
+    {
+        Uint16 slot;
+        if(m_free != no_slot)
+        {
+            slot = m_free;
+            m_free = m_slots.at(slot).index;
+        }
+        else
+        {
+            //numer no_slot oznacza brak wolnego miejsca, więc nie może zostać nadany elementowi
+            SDL_assert(m_slots.size() < no_slot);
+            if(m_slots.size() >= no_slot) return null_handle;
+            slot = m_slots.size();
+            m_slots.push_back({1, 0});
+        }
+        m_slots.at(slot).index = m_values.size();
+        m_values.push_back(value);
+        m_slot_of.push_back(slot);
+        return makeHandle(slot);
+    }
+    /**
+     * Usunięcie elementu wskazanego uchwytem.
+     * @param handle - uchwyt elementu
+     * @return true jeśli uchwyt był ważny
+     */
+    bool erase(Handle handle)
+    {
+        if(!contains(handle)) return false;
+        eraseAt(m_slots.at(handle & 0xFFFF).index);
+        return true;
+    }
+    /**
+     * Usunięcie elementu o podanym położeniu w tablicy. Na jego miejsce trafia ostatni element.
+     * @param index - położenie elementu z przedziału [0, size())
+     */
+    void eraseAt(unsigned index)
+    {
+        Uint16 slot = m_slot_of.at(index);
+        unsigned last = m_values.size() - 1;
+        if(index != last)
+        {
+            m_values.at(index) = m_values.at(last);
+            m_slot_of.at(index) = m_slot_of.at(last);
+            m_slots.at(m_slot_of.at(index)).index = index;
+        }
+        m_values.pop_back();
+        m_slot_of.pop_back();
+
+        Slot& s = m_slots.at(slot);
+        s.generation++;
+        if(s.generation == 0) s.generation = 1; //generacja 0 jest zarezerwowana dla null_handle
+        s.index = m_free;
+        m_free = slot;
+    }
+    /**
+     * @param handle - uchwyt elementu
+     * @return true jeśli uchwyt wskazuje na istniejący element
+     */
+    bool contains(Handle handle) const
+    {
+        Uint16 slot = handle & 0xFFFF;
+        if(slot >= m_slots.size()) return false;
+        const Slot& s = m_slots.at(slot);
+        return s.generation == handle >> 16 && s.index < m_values.size() && m_slot_of.at(s.index) == slot;
+    }
+    /**
+     * @param handle - uchwyt elementu
+     * @return wskaźnik na element lub nullptr jeśli uchwyt nie jest ważny
+     */
+    T* get(Handle handle)
+    {
+        if(!contains(handle)) return nullptr;
+        return &m_values.at(m_slots.at(handle & 0xFFFF).index);
+    }
+    /**
+     * @param handle - uchwyt elementu
+     * @return położenie elementu w tablicy lub -1 jeśli uchwyt nie jest ważny
+     */
+    int indexOf(Handle handle) const
+    {
+        if(!contains(handle)) return -1;
+        return m_slots.at(handle & 0xFFFF).index;
+    }
+    /**
+     * @param index - położenie elementu z przedziału [0, size())
+     * @return uchwyt elementu
+     */
+    Handle handleAt(unsigned index) const
+    {
+        return makeHandle(m_slot_of.at(index));
+    }
+
+    /**
+     * Rezerwacja pamięci na podaną liczbę elementów, aby kolejne wstawienia nie odwoływały się do sterty.
+     * @param count - liczba elementów
+     */
+    void reserve(unsigned count)
+    {
+        m_values.reserve(count);
+        m_slot_of.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    T& at(unsigned index) { return m_values.at(index); }
+    const T& at(unsigned index) const { return m_values.at(index); }
+    unsigned size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+    iterator begin() { return m_values.begin(); }
+    iterator end() { return m_values.end(); }
+    const_iterator begin() const { return m_values.begin(); }
+    const_iterator end() const { return m_values.end(); }
+
+    /**
+     * Usunięcie wszystkich elementów; wszystkie wydane uchwyty przestają być ważne.
+     */
+    void clear()
+    {
+        while(!m_values.empty()) eraseAt(m_values.size() - 1);
+    }
+
+private:
+    /**
+     * @brief Miejsce, na które wskazuje uchwyt.
+     */
+    struct Slot
+    {
+        /**
+         * Generacja miejsca zwiększana przy każdym usunięciu elementu.
+         */
+        Uint16 generation;
+        /**
+         * Dla zajętego miejsca położenie elementu w tablicy, dla wolnego numer następnego wolnego miejsca.
+         */
+        Uint16 index;
+    };
+
+    Handle makeHandle(Uint16 slot) const
+    {
+        return static_cast<Handle>(m_slots.at(slot).generation) << 16 | slot;
+    }
+
+    static const Uint16 no_slot = 0xFFFF;
+
+    /**
+     * Elementy ułożone w ciągłej tablicy.
+     */
+    std::vector<T> m_values;
+    /**
+     * Numer miejsca dla każdego elementu tablicy @a m_values.
+     */
+    std::vector<Uint16> m_slot_of;
+    /**
+     * Wszystkie miejsca, zajęte i wolne.
+     */
+    std::vector<Slot> m_slots;
+    /**
+     * Pierwsze wolne miejsce; wartość @a no_slot oznacza brak wolnych miejsc.
+     */
+    Uint16 m_free;
+};
+
+#endif // SLOTMAP_H
@@ -0,0 +1,220 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief
+ * Szablon równomiernej siatki kubełków przechowującej punkty z przypisanymi wartościami, pozwalającej szybko znaleźć punkt najbliższy w metryce miejskiej (Manhattan).
+ * Wyszukiwanie przegląda kubełki pierścieniami wokół szukanego punktu i kończy się, gdy kolejny pierścień nie może zawierać bliższego punktu,
+ * więc jego koszt zależy od liczby punktów w pobliżu, a nie od liczby wszystkich punktów. Punkty spoza obszaru siatki trafiają do skrajnych kubełków.
+ * Punkty wszystkich kubełków leżą w jednej tablicy, a kubełek jest listą połączoną indeksami tej tablicy; tablica zachowuje pamięć po @a SpatialGrid::clear,
+ * więc ponowne wypełnianie siatki w każdej klatce nie przydziela pamięci, dopóki liczba punktów nie przekroczy największej dotychczasowej.
+ * @tparam T - typ wartości przypisanych punktom
+ */
+template <class T>
+class SpatialGrid
+{
+public:
+    /**
+     * Liczba punktów, do której wyszukiwanie przegląda wszystkie niepuste kubełki zamiast pierścieni.
+     */
+    static const unsigned linear_scan_limit = 16;
+
+    SpatialGrid()
+    {
+        m_area = {0, 0, 0, 0};
+        m_cell_size = 1;
+        m_columns_count = 0;
+        m_rows_count = 0;
+        m_count = 0;
+    }
+
+    /**
+     * Ustawienie obszaru i rozmiaru kubełków; siatka zostaje opróżniona.
+     * @param area - obszar pokryty kubełkami
+     * @param cell_size - bok kubełka w pikselach
+     */
+    void reset(const SDL_Rect& area, int cell_size)
+    {
+        m_area = area;
+        m_cell_size = std::max(cell_size, 1);
+        m_columns_count = std::max((area.w + m_cell_size - 1) / m_cell_size, 1);
+        m_rows_count = std::max((area.h + m_cell_size - 1) / m_cell_size, 1);
+        m_cells.assign(m_columns_count * m_rows_count, no_entry);
+        m_used_cells.clear();
+        m_entries.clear();
+        m_count = 0;
+    }
+    /**
+     * Rezerwacja pamięci na podaną liczbę punktów, aby ich dodawanie nie przydzielało pamięci.
+     * @param count - liczba punktów
+     */
+    void reserve(unsigned count)
+    {
+        m_entries.reserve(count);
+        m_used_cells.reserve(count);
+    }
+    /**
+     * Usunięcie wszystkich punktów.
+     */
+    void clear()
+    {
+        for(auto index : m_used_cells) m_cells[index] = no_entry;
+        m_used_cells.clear();
+        m_entries.clear();
+        m_count = 0;
+    }
+    /**
+     * Dodanie punktu.
+     * @param point - położenie punktu
+     * @param value - wartość przypisana punktowi
+     */
+    void insert(const SDL_Point& point, const T& value)
+    {
+        if(m_cells.empty()) return;
+        int index = row(point.y) * m_columns_count + column(point.x);
+        if(m_cells[index] == no_entry) m_used_cells.push_back(index);
+        m_entries.push_back({point, value, m_count++, m_cells[index]});
+        m_cells[index] = m_entries.size() - 1;
+    }
+    /**
+     * Wyszukanie punktu najbliższego w metryce miejskiej. Spośród równie bliskich punktów wybierany jest dodany najwcześniej.
+     * @param point - punkt, od którego liczona jest odległość
+     * @param max_distance - odległość, od której znaleziony punkt musi być mniejszy
+     * @param value - wartość najbliższego punktu
+     * @param distance - odległość do najbliższego punktu
+     * @return true jeśli znaleziono punkt bliższy niż @a max_distance
+     */
+    bool nearest(const SDL_Point& point, int max_distance, T& value, int& distance) const
+    {
+        if(m_cells.empty()) return false;
+        const Entry* best = nullptr;
+        int best_distance = max_distance;
+        auto check = [&](int cell)
+        {
+            for(int i = m_cells[cell]; i != no_entry; i = m_entries[i].next)
+            {
+                const Entry& entry = m_entries[i];
+                int d = std::abs(entry.point.x - point.x) + std::abs(entry.point.y - point.y);
+                if(d < best_distance || (best != nullptr && d == best_distance && entry.order < best->order))
+                {
+                    best = &entry;
+                    best_distance = d;
+                }
+            }
+        };
+
+        if(m_count <= linear_scan_limit)
+        {
+            //przy niewielu punktach przejrzenie niepustych kubełków jest tańsze niż przeglądanie pustych pierścieni
+            for(auto index : m_used_cells) check(index);
+        }
+        else
+        {
+            int qx = column(point.x), qy = row(point.y);
+            int rings = std::max(m_columns_count, m_rows_count);
+            for(int k = 0; k <= rings; k++)
+            {
+                if(k > 0 && coveredDistance(point, qx, qy, k) >= best_distance) break;
+                for(int y = std::max(qy - k, 0); y <= std::min(qy + k, m_rows_count - 1); y++)
+                {
+                    bool edge_row = y == qy - k || y == qy + k;
+                    for(int x = std::max(qx - k, 0); x <= std::min(qx + k, m_columns_count - 1); x++)
+                    {
+                        if(!edge_row && x != qx - k && x != qx + k) continue; //wnętrze pierścienia przejrzano wcześniej
+                        check(y * m_columns_count + x);
+                    }
+                }
+            }
+        }
+        if(best == nullptr) return false;
+        value = best->value;
+        distance = best_distance;
+        return true;
+    }
+    /**
+     * @return liczbę punktów w siatce
+     */
+    unsigned size() const
+    {
+        return m_count;
+    }
+
+private:
+    /**
+     * @brief Punkt w kubełku.
+     */
+    struct Entry
+    {
+        SDL_Point point;
+        T value;
+        /**
+         * Kolejność dodania punktu; rozstrzyga wybór spośród równie bliskich punktów.
+         */
+        unsigned order;
+        /**
+         * Indeks następnego punktu tego samego kubełka w @a m_entries lub @a no_entry.
+         */
+        int next;
+    };
+
+    static const int no_entry = -1;
+
+    /**
+     * Odległość, do której włącznie wszystkie punkty leżą w pierścieniach 0..k-1 wokół kubełka (qx, qy).
+     * Liczona jest od rzeczywistego położenia szukanego punktu do najbliższej krawędzi nieprzejrzanych kubełków; strony, po których przejrzano już skrajne kubełki siatki, są pomijane,
+     * bo punkty spoza obszaru trafiają do skrajnych kubełków i leżą od szukanego punktu dalej niż ich kubełek.
+     * @return odległość lub INT_MAX, jeśli przejrzano wszystkie kubełki
+     */
+    int coveredDistance(const SDL_Point& point, int qx, int qy, int k) const
+    {
+        int covered = INT_MAX;
+        if(qx - k >= 0) covered = std::min(covered, point.x - m_area.x - (qx - k + 1) * m_cell_size);
+        if(qx + k < m_columns_count) covered = std::min(covered, m_area.x + (qx + k) * m_cell_size - point.x - 1);
+        if(qy - k >= 0) covered = std::min(covered, point.y - m_area.y - (qy - k + 1) * m_cell_size);
+        if(qy + k < m_rows_count) covered = std::min(covered, m_area.y + (qy + k) * m_cell_size - point.y - 1);
+        return covered;
+    }
+    /**
+     * @return kolumnę kubełka zawierającego współrzędną poziomą
+     */
+    int column(int x) const
+    {
+        return std::min(std::max((x - m_area.x) / m_cell_size, 0), m_columns_count - 1);
+    }
+    /**
+     * @return wiersz kubełka zawierającego współrzędną pionową
+     */
+    int row(int y) const
+    {
+        return std::min(std::max((y - m_area.y) / m_cell_size, 0), m_rows_count - 1);
+    }
+
+    SDL_Rect m_area;
+    int m_cell_size;
+    int m_columns_count;
+    int m_rows_count;
+    unsigned m_count;
+    /**
+     * Indeks pierwszego punktu każdego kubełka w @a m_entries lub @a no_entry; kubełki są zapisane wierszami.
+     */
+    std::vector<int> m_cells;
+    /**
+     * Punkty wszystkich kubełków w kolejności dodania.
+     */
+    std::vector<Entry> m_entries;
+    /**
+     * Numery niepustych kubełków; @a SpatialGrid::clear opróżnia tylko je.
+     */
+    std::vector<int> m_used_cells;
+};
+
+template <class T>
+const int SpatialGrid<T>::no_entry;
+
+#endif // SPATIALGRID_H
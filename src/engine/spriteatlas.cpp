@@ -0,0 +1,352 @@
+#include "spriteatlas.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+/**
+ * @brief Odcinek górnej krawędzi zajętego obszaru tekstury.
+ */
+struct SkylineNode
+{
+    int x;
+    int y;
+    int width;
+};
+
+/**
+ * Lista plików PNG w katalogu posortowana według nazw.
+ * @param dir - katalog
+ * @return nazwy plików
+ */
+static std::vector<std::string> listImages(const std::string& dir)
+{
+    std::vector<std::string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA((dir + "/*.png").c_str(), &entry);
+    if(find == INVALID_HANDLE_VALUE) return names;
+    do
+    {
+        if(!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) names.push_back(entry.cFileName);
+    } while(FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* directory = opendir(dir.c_str());
+    if(directory == nullptr) return names;
+    while(dirent* entry = readdir(directory))
+    {
+        std::string name = entry->d_name;
+        if(name.size() > 4 && name.compare(name.size() - 4, 4, ".png") == 0) names.push_back(name);
+    }
+    closedir(directory);
+#endif
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/**
+ * Dopisanie danych do sumy kontrolnej FNV-1a.
+ * @param hash - dotychczasowa suma
+ * @param data - dane
+ * @param size - liczba bajtów
+ * @return nowa suma
+ */
+static Uint32 addChecksum(Uint32 hash, const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for(std::size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Dopisanie pikseli do sumy kontrolnej; piksele są mieszane całymi słowami, co przy dużej teksturze jest kilka razy szybsze niż mieszanie bajtów.
+ * @param hash - dotychczasowa suma
+ * @param pixels - piksele
+ * @param count - liczba pikseli
+ * @return nowa suma
+ */
+static Uint32 addPixelsChecksum(Uint32 hash, const Uint32* pixels, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; i++)
+    {
+        hash ^= pixels[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Sprawdzenie, czy prostokąt o szerokości @a width zaczynający się na początku odcinka @a index mieści się w teksturze.
+ * @param y - najniższe położenie, na którym prostokąt nie nachodzi na zajęty obszar
+ * @return true jeśli prostokąt mieści się w szerokości tekstury
+ */
+static bool skylineFit(const std::vector<SkylineNode>& skyline, std::size_t index, int width, int atlas_width, int& y)
+{
+    if(skyline[index].x + width > atlas_width) return false;
+    y = 0;
+    for(int remaining = width; remaining > 0; index++)
+    {
+        if(index >= skyline.size()) return false;
+        y = std::max(y, skyline[index].y);
+        remaining -= skyline[index].width;
+    }
+    return true;
+}
+
+/**
+ * Umieszczenie prostokąta najniżej, a przy równej wysokości najbardziej na lewo (bottom-left) i uaktualnienie krawędzi zajętego obszaru.
+ * @param rect - prostokąt; jego wymiary są dane, a położenie jest wynikiem
+ * @return true jeśli prostokąt zmieścił się w szerokości tekstury
+ */
+static bool skylinePlace(std::vector<SkylineNode>& skyline, int atlas_width, SDL_Rect& rect)
+{
+    std::size_t best = skyline.size();
+    int best_y = 0;
+    for(std::size_t i = 0; i < skyline.size(); i++)
+    {
+        int y;
+        if(skylineFit(skyline, i, rect.w, atlas_width, y) && (best == skyline.size() || y < best_y))
+        {
+            best = i;
+            best_y = y;
+        }
+    }
+    if(best == skyline.size()) return false;
+
+    rect.x = skyline[best].x;
+    rect.y = best_y;
+    SkylineNode node = {rect.x, rect.y + rect.h, rect.w};
+    skyline.insert(skyline.begin() + best, node);
+
+    //skrócenie lub usunięcie odcinków przykrytych nowym prostokątem
+    for(std::size_t i = best + 1; i < skyline.size(); )
+    {
+        int overlap = node.x + node.width - skyline[i].x;
+        if(overlap <= 0) break;
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if(skyline[i].width > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+    //połączenie sąsiednich odcinków na tej samej wysokości
+    for(std::size_t i = 0; i + 1 < skyline.size(); )
+    {
+        if(skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else i++;
+    }
+    return true;
+}
+
+SpriteAtlas::SpriteAtlas()
+{
+    m_data = nullptr;
+    m_width = 0;
+    m_height = 0;
+}
+
+bool SpriteAtlas::build(const Uint32* base, int base_width, int base_height, const std::string& dir, const std::string& cache_path)
+{
+    std::vector<std::string> names = listImages(dir);
+    if(names.empty()) return false;
+
+    //suma kontrolna obejmuje główną teksturę oraz nazwy i zawartość plików
+    std::vector<std::vector<char>> files(names.size());
+    Uint32 checksum = 2166136261u;
+    checksum = addChecksum(checksum, &base_width, sizeof(base_width));
+    checksum = addChecksum(checksum, &base_height, sizeof(base_height));
+    checksum = addPixelsChecksum(checksum, base, static_cast<std::size_t>(base_width) * base_height);
+    for(std::size_t i = 0; i < names.size(); i++)
+    {
+        std::ifstream file(dir + "/" + names.at(i), std::ios::binary);
+        files.at(i).assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        checksum = addChecksum(checksum, names.at(i).c_str(), names.at(i).size() + 1);
+        checksum = addChecksum(checksum, files.at(i).data(), files.at(i).size());
+    }
+    if(loadCache(cache_path, checksum)) return true;
+
+    //dekodowanie obrazków
+    if(!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return false;
+    std::vector<SDL_Surface*> surfaces;
+    int atlas_width = base_width;
+    for(std::size_t i = 0; i < names.size(); i++)
+    {
+        SDL_Surface* loaded = IMG_Load_RW(SDL_RWFromConstMem(files.at(i).data(), files.at(i).size()), 1);
+        SDL_Surface* surface = loaded != nullptr ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ABGR8888, 0) : nullptr;
+        SDL_FreeSurface(loaded);
+        if(surface == nullptr)
+        {
+            std::cerr << "sprite " << names.at(i) << " skipped: " << SDL_GetError() << std::endl;
+            continue;
+        }
+        Sprite sprite;
+        sprite.name = names.at(i).substr(0, names.at(i).size() - 4).substr(0, sizeof(Record::name) - 1);
+        sprite.rect = {0, 0, surface->w, surface->h};
+        m_sprites.push_back(sprite);
+        surfaces.push_back(surface);
+        atlas_width = std::max(atlas_width, surface->w);
+    }
+
+    //układanie od najwyższych obrazków; główna tekstura zajmuje lewy górny róg
+    std::vector<std::size_t> order(m_sprites.size());
+    for(std::size_t i = 0; i < order.size(); i++) order.at(i) = i;
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        const SDL_Rect& ra = m_sprites.at(a).rect;
+        const SDL_Rect& rb = m_sprites.at(b).rect;
+        return ra.h != rb.h ? ra.h > rb.h : ra.w > rb.w;
+    });
+    std::vector<SkylineNode> skyline;
+    skyline.push_back({0, base_height, base_width});
+    if(atlas_width > base_width) skyline.push_back({base_width, 0, atlas_width - base_width});
+    bool packed = true;
+    int atlas_height = base_height;
+    for(std::size_t i : order)
+    {
+        SDL_Rect& rect = m_sprites.at(i).rect;
+        packed = skylinePlace(skyline, atlas_width, rect) && rect.y + rect.h <= max_height;
+        if(!packed) break;
+        atlas_height = std::max(atlas_height, rect.y + rect.h);
+    }
+
+    if(packed)
+    {
+        m_width = atlas_width;
+        m_height = atlas_height;
+        m_pixels.assign(static_cast<std::size_t>(m_width) * m_height, 0);
+        for(int y = 0; y < base_height; y++)
+            std::memcpy(&m_pixels[static_cast<std::size_t>(y) * m_width], base + static_cast<std::size_t>(y) * base_width, base_width * 4);
+        for(std::size_t i = 0; i < m_sprites.size(); i++)
+        {
+            SDL_Surface* surface = surfaces.at(i);
+            const SDL_Rect& rect = m_sprites.at(i).rect;
+            SDL_LockSurface(surface);
+            for(int y = 0; y < rect.h; y++)
+                std::memcpy(&m_pixels[static_cast<std::size_t>(rect.y + y) * m_width + rect.x],
+                            static_cast<const char*>(surface->pixels) + y * surface->pitch, rect.w * 4);
+            SDL_UnlockSurface(surface);
+        }
+        m_data = m_pixels.data();
+        saveCache(cache_path, checksum);
+    }
+    else
+    {
+        std::cerr << "sprites from " << dir << " do not fit in " << atlas_width << "x" << max_height << " texture" << std::endl;
+        m_sprites.clear();
+    }
+
+    for(auto surface : surfaces) SDL_FreeSurface(surface);
+    return packed;
+}
+
+bool SpriteAtlas::loadCache(const std::string& cache_path, Uint32 checksum)
+{
+    if(!m_cache.open(cache_path)) return false;
+
+    Header header;
+    bool valid = m_cache.size() >= sizeof(Header);
+    if(valid)
+    {
+        std::memcpy(&header, m_cache.data(), sizeof(Header));
+        valid = header.magic == magic && header.version == version && header.source_checksum == checksum
+                && header.height <= static_cast<Uint32>(max_height) && header.width <= 0xFFFF
+                && header.sprites_count <= (m_cache.size() - sizeof(Header)) / sizeof(Record)
+                && static_cast<Uint64>(header.width) * header.height * 4 == m_cache.size() - sizeof(Header) - header.sprites_count * sizeof(Record);
+    }
+    if(!valid)
+    {
+        m_cache.close();
+        return false;
+    }
+
+    m_sprites.clear();
+    const char* data = m_cache.data() + sizeof(Header);
+    for(Uint32 i = 0; i < header.sprites_count; i++, data += sizeof(Record))
+    {
+        Record record;
+        std::memcpy(&record, data, sizeof(Record));
+        record.name[sizeof(record.name) - 1] = '\0';
+        Sprite sprite;
+        sprite.name = record.name;
+        sprite.rect = {record.x, record.y, record.w, record.h};
+        m_sprites.push_back(sprite);
+    }
+    m_width = header.width;
+    m_height = header.height;
+    m_data = reinterpret_cast<const Uint32*>(data);
+    return true;
+}
+
+void SpriteAtlas::saveCache(const std::string& cache_path, Uint32 checksum) const
+{
+    Header header;
+    header.magic = magic;
+    header.version = version;
+    header.source_checksum = checksum;
+    header.width = m_width;
+    header.height = m_height;
+    header.sprites_count = m_sprites.size();
+
+    std::string temp_path = cache_path + ".tmp";
+    std::ofstream out(temp_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(auto& sprite : m_sprites)
+    {
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        std::strncpy(record.name, sprite.name.c_str(), sizeof(record.name) - 1);
+        record.x = sprite.rect.x;
+        record.y = sprite.rect.y;
+        record.w = sprite.rect.w;
+        record.h = sprite.rect.h;
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    out.write(reinterpret_cast<const char*>(m_pixels.data()), m_pixels.size() * 4);
+    out.close();
+    //nieudany zapis pozostawia poprzedni plik podręczny; zostanie odrzucony przy wczytywaniu przez niezgodną sumę kontrolną
+    if(!out) std::remove(temp_path.c_str());
+    else if(!MappedFile::replace(temp_path, cache_path)) std::cerr << "cannot replace sprite cache " << cache_path << std::endl;
+}
+
+const Uint32* SpriteAtlas::pixels() const
+{
+    return m_data;
+}
+
+int SpriteAtlas::width() const
+{
+    return m_width;
+}
+
+int SpriteAtlas::height() const
+{
+    return m_height;
+}
+
+const std::vector<SpriteAtlas::Sprite>& SpriteAtlas::sprites() const
+{
+    return m_sprites;
+}
+
+void SpriteAtlas::releasePixels()
+{
+    std::vector<Uint32>().swap(m_pixels);
+    m_cache.close();
+    m_data = nullptr;
+}
@@ -0,0 +1,137 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include "mappedfile.h"
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa składa główną teksturę obiektów i obrazki PNG z katalogu sprite'ów (np. skórek lub modyfikacji) w jedną teksturę,
+ * dzięki czemu wszystkie obiekty nadal są rysowane z jednej tekstury.
+ * Główna tekstura pozostaje w lewym górnym rogu, więc jej współrzędne w @a SpriteConfig nie zmieniają się, a obrazki są układane
+ * algorytmem skyline w wolnym miejscu obok niej i pod nią.
+ * Wynik jest zapisywany w pliku podręcznym razem z sumą kontrolną głównej tekstury i plików obrazków; przy zgodnej sumie obrazki nie są ponownie dekodowane ani układane.
+ * Plik podręczny składa się z nagłówka @a SpriteAtlas::Header, rekordów @a SpriteAtlas::Record i pikseli w formacie SDL_PIXELFORMAT_ABGR8888.
+ */
+class SpriteAtlas
+{
+public:
+    /**
+     * @brief Obrazek umieszczony w teksturze.
+     */
+    struct Sprite
+    {
+        /**
+         * Nazwa pliku bez rozszerzenia.
+         */
+        std::string name;
+        /**
+         * Położenie i wymiary obrazka w teksturze.
+         */
+        SDL_Rect rect;
+    };
+    /**
+     * @brief Nagłówek pliku podręcznego.
+     */
+    struct Header
+    {
+        /**
+         * Znacznik pliku; zawsze @a SpriteAtlas::magic.
+         */
+        Uint32 magic;
+        /**
+         * Wersja formatu; zawsze @a SpriteAtlas::version.
+         */
+        Uint32 version;
+        /**
+         * Suma kontrolna głównej tekstury oraz nazw i zawartości plików obrazków.
+         */
+        Uint32 source_checksum;
+        Uint32 width;
+        Uint32 height;
+        /**
+         * Liczba rekordów obrazków.
+         */
+        Uint32 sprites_count;
+    };
+    /**
+     * @brief Obrazek zapisany w pliku podręcznym.
+     */
+    struct Record
+    {
+        /**
+         * Nazwa obrazka zakończona zerem.
+         */
+        char name[48];
+        Sint32 x;
+        Sint32 y;
+        Sint32 w;
+        Sint32 h;
+    };
+
+    static const Uint32 magic = 0x43505354; //"TSPC"
+    static const Uint32 version = 1;
+    /**
+     * Największa wysokość tekstury.
+     */
+    static const int max_height = 4096;
+
+    SpriteAtlas();
+
+    /**
+     * Złożenie tekstury z głównej tekstury i obrazków z katalogu albo wczytanie jej z pliku podręcznego.
+     * @param base - piksele głównej tekstury w formacie SDL_PIXELFORMAT_ABGR8888
+     * @param base_width - szerokość głównej tekstury
+     * @param base_height - wysokość głównej tekstury
+     * @param dir - katalog z obrazkami PNG
+     * @param cache_path - ścieżka do pliku podręcznego
+     * @return true jeśli w katalogu były obrazki i udało się złożyć teksturę
+     */
+    bool build(const Uint32* base, int base_width, int base_height, const std::string& dir, const std::string& cache_path);
+    /**
+     * @return piksele złożonej tekstury w formacie SDL_PIXELFORMAT_ABGR8888 lub nullptr, jeśli tekstura nie została złożona
+     */
+    const Uint32* pixels() const;
+    int width() const;
+    int height() const;
+    /**
+     * @return obrazki umieszczone w teksturze
+     */
+    const std::vector<Sprite>& sprites() const;
+    /**
+     * Zwolnienie pikseli po stworzeniu tekstury; położenia obrazków pozostają dostępne.
+     */
+    void releasePixels();
+
+private:
+    /**
+     * Wczytanie tekstury z pliku podręcznego.
+     * @return true jeśli plik istnieje, jest poprawny, a jego suma kontrolna jest równa @a checksum
+     */
+    bool loadCache(const std::string& cache_path, Uint32 checksum);
+    /**
+     * Zapisanie tekstury w pliku podręcznym. Plik jest zapisywany obok pod nazwą tymczasową i zastępuje poprzedni dopiero w całości,
+     * bo inna uruchomiona kopia gry może mieć poprzedni plik odwzorowany w pamięci (@a MappedFile::replace).
+     */
+    void saveCache(const std::string& cache_path, Uint32 checksum) const;
+
+    /**
+     * Piksele złożonej tekstury.
+     */
+    std::vector<Uint32> m_pixels;
+    /**
+     * Plik podręczny odwzorowany w pamięci, jeśli tekstura została z niego wczytana.
+     */
+    MappedFile m_cache;
+    /**
+     * Piksele tekstury w @a SpriteAtlas::m_pixels lub w pliku podręcznym.
+     */
+    const Uint32* m_data;
+    int m_width;
+    int m_height;
+    std::vector<Sprite> m_sprites;
+};
+
+#endif // SPRITEATLAS_H
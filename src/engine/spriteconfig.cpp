@@ -1,4 +1,6 @@
 #include "spriteconfig.h"
+#include "spriteatlas.h"
+#include <iostream>
 
 SpriteConfig::SpriteConfig()
 {
@@ -53,3 +55,100 @@ void SpriteConfig::insert(SpriteType st, int x, int y, int w, int h, int fc, int
 {
     m_configs[st] = SpriteData(x, y, w, h, fc, fd, l);
 }
+
+const SpriteData* SpriteConfig::getSpriteData(const std::string& name) const
+{
+    auto it = m_named_configs.find(name);
+    return it != m_named_configs.end() ? &it->second : nullptr;
+}
+
+/**
+ * Obszar tekstury, z którego korzystają obiekty danego typu, liczony w klatkach względem pierwszej klatki animacji:
+ * x - pierwsza kolumna, w - liczba kolumn (kierunki, poziomy pancerza), h - liczba wierszy (klatki animacji, stany).
+ * @param st - typ animacji
+ * @param data - animacja
+ * @return obszar animacji
+ */
+static SDL_Rect spriteRegion(SpriteType st, const SpriteData& data)
+{
+    switch(st)
+    {
+    case ST_TANK_A:
+    case ST_TANK_B:
+    case ST_TANK_C:
+    case ST_TANK_D:
+        return {-4, 0, 20, data.frames_count}; //cztery kierunki wroga z bonusem oraz po cztery kierunki dla każdego poziomu pancerza
+    case ST_PLAYER_1:
+    case ST_PLAYER_2:
+        return {0, 0, 4, data.frames_count + 6}; //cztery kierunki, po dwie klatki dla każdej liczby gwiazdek
+    case ST_BRICK_WALL:
+        return {0, 0, 1, 9}; //stany zniszczenia murku
+    case ST_BULLET:
+        return {0, 0, 4, data.frames_count}; //cztery kierunki
+    default:
+        return {0, 0, 1, data.frames_count};
+    }
+}
+
+void SpriteConfig::insertAtlas(const SpriteAtlas* atlas)
+{
+    std::map<std::string, SpriteType> types;
+    for(int st = 0; st < ST_NONE; st++) types[spriteName(static_cast<SpriteType>(st))] = static_cast<SpriteType>(st);
+
+    for(auto& sprite : atlas->sprites())
+    {
+        m_named_configs[sprite.name] = SpriteData(sprite.rect.x, sprite.rect.y, sprite.rect.w, sprite.rect.h, 1, 200, false);
+
+        auto type = types.find(sprite.name);
+        if(type == types.end()) continue;
+        SpriteData& data = m_configs.at(type->second);
+        SDL_Rect region = spriteRegion(type->second, data);
+        if(sprite.rect.w < region.w * data.rect.w || sprite.rect.h < region.h * data.rect.h)
+        {
+            std::cerr << "sprite " << sprite.name << " is smaller than " << region.w * data.rect.w << "x" << region.h * data.rect.h << ", not used" << std::endl;
+            continue;
+        }
+        data.rect.x = sprite.rect.x - region.x * data.rect.w;
+        data.rect.y = sprite.rect.y - region.y * data.rect.h;
+    }
+}
+
+const char* SpriteConfig::spriteName(SpriteType st)
+{
+    switch(st)
+    {
+    case ST_TANK_A: return "enemy_a";
+    case ST_TANK_B: return "enemy_b";
+    case ST_TANK_C: return "enemy_c";
+    case ST_TANK_D: return "enemy_d";
+    case ST_PLAYER_1: return "player_1";
+    case ST_PLAYER_2: return "player_2";
+    case ST_BRICK_WALL: return "brick";
+    case ST_STONE_WALL: return "stone";
+    case ST_WATER: return "water";
+    case ST_BUSH: return "bush";
+    case ST_ICE: return "ice";
+    case ST_BONUS_GRENADE: return "bonus_grenade";
+    case ST_BONUS_HELMET: return "bonus_helmet";
+    case ST_BONUS_CLOCK: return "bonus_clock";
+    case ST_BONUS_SHOVEL: return "bonus_shovel";
+    case ST_BONUS_TANK: return "bonus_tank";
+    case ST_BONUS_STAR: return "bonus_star";
+    case ST_BONUS_GUN: return "bonus_gun";
+    case ST_BONUS_BOAT: return "bonus_boat";
+    case ST_SHIELD: return "shield";
+    case ST_CREATE: return "create";
+    case ST_DESTROY_TANK: return "destroy_tank";
+    case ST_DESTROY_BULLET: return "destroy_bullet";
+    case ST_BOAT_P1: return "boat_p1";
+    case ST_BOAT_P2: return "boat_p2";
+    case ST_EAGLE: return "eagle";
+    case ST_DESTROY_EAGLE: return "destroy_eagle";
+    case ST_FLAG: return "flag";
+    case ST_BULLET: return "bullet";
+    case ST_LEFT_ENEMY: return "left_enemy";
+    case ST_STAGE_STATUS: return "stage_status";
+    case ST_TANKS_LOGO: return "tanks_logo";
+    default: return "";
+    }
+}
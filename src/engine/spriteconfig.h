@@ -3,6 +3,7 @@
 
 #include "../type.h"
 #include <map>
+#include <string>
 #include <SDL2/SDL.h>
 
 /**
@@ -33,6 +34,8 @@ struct SpriteData
     bool loop;
 };
 
+class SpriteAtlas;
+
 /**
  * @brief
  * Klasa przechowuje informacjie o wszystkich typach animacji w grze.
@@ -50,11 +53,33 @@ public:
      * @return animację danego typu
      */
     const SpriteData* getSpriteData(SpriteType sp) const;
+    /**
+     * Pobranie obrazka z katalogu sprite'ów.
+     * @param name - nazwa pliku obrazka bez rozszerzenia
+     * @return jednoklatkową animację z całym obrazkiem lub nullptr, jeśli nie ma takiego obrazka
+     */
+    const SpriteData* getSpriteData(const std::string& name) const;
+    /**
+     * Dodanie obrazków z katalogu sprite'ów umieszczonych w teksturze obiektów.
+     * Każdy obrazek jest dostępny pod swoją nazwą, a obrazek o nazwie typu animacji (@a SpriteConfig::spriteName) zastępuje jej wygląd,
+     * o ile mieści wszystkie klatki i warianty, z których korzystają obiekty tego typu; liczba klatek, ich rozmiar i czas wyświetlania nie zmieniają się.
+     * @param atlas - obrazki umieszczone w teksturze
+     */
+    void insertAtlas(const SpriteAtlas* atlas);
+    /**
+     * @param st - typ animacji
+     * @return nazwę pliku obrazka zastępującego animację, bez rozszerzenia
+     */
+    static const char* spriteName(SpriteType st);
 private:
     /**
      * Kontener przechowujący wszystkie typy animacji.
      */
     std::map<SpriteType, SpriteData> m_configs;
+    /**
+     * Obrazki z katalogu sprite'ów według nazw.
+     */
+    std::map<std::string, SpriteData> m_named_configs;
     /**
      * Funkcja używana przy dodawaniu nowego typu animacji.
      * @param st - typ animacji
@@ -0,0 +1,104 @@
+#include "startuptimeline.h"
+#include <iomanip>
+
+/**
+ * @brief Zapis jednego etapu.
+ */
+struct StageRecord
+{
+    Uint64 begin;
+    Uint64 end;
+    SDL_threadID thread;
+};
+
+static Uint64 s_origin = 0;
+static SDL_threadID s_main_thread = 0;
+static StageRecord s_stages[SS_COUNT];
+
+void StartupTimeline::start()
+{
+    s_origin = SDL_GetPerformanceCounter();
+    s_main_thread = SDL_ThreadID();
+    for(auto& stage : s_stages) stage = StageRecord{0, 0, 0};
+}
+
+void StartupTimeline::begin(StartupStage stage)
+{
+    s_stages[stage].begin = SDL_GetPerformanceCounter();
+    s_stages[stage].thread = SDL_ThreadID();
+}
+
+void StartupTimeline::end(StartupStage stage)
+{
+    s_stages[stage].end = SDL_GetPerformanceCounter();
+}
+
+const char* StartupTimeline::stageName(StartupStage stage)
+{
+    switch(stage)
+    {
+    case SS_SDL_INIT: return "SDL_INIT";
+    case SS_WINDOW: return "WINDOW";
+    case SS_RENDERER: return "RENDERER";
+    case SS_TEXTURE: return "TEXTURE";
+    case SS_FONT: return "FONT";
+    case SS_SPRITES: return "SPRITES";
+    case SS_LEVELS: return "LEVELS";
+    case SS_UPLOAD: return "UPLOAD";
+    case SS_MENU: return "MENU";
+    case SS_FIRST_FRAME: return "FIRST_FRAME";
+    default: return "?";
+    }
+}
+
+void StartupTimeline::report(std::ostream& out)
+{
+    double ms = 1000.0 / SDL_GetPerformanceFrequency();
+    Uint64 last = s_origin;
+    std::streamsize precision = out.precision();
+    out << "startup timeline (ms):" << std::endl;
+    out << std::left << std::setw(12) << "stage" << std::right << std::setw(8) << "thread"
+        << std::setw(10) << "begin" << std::setw(10) << "end" << std::setw(10) << "time" << std::endl;
+    out << std::fixed << std::setprecision(2);
+    for(int i = 0; i < SS_COUNT; i++)
+    {
+        const StageRecord& stage = s_stages[i];
+        if(stage.end == 0) continue;
+        out << std::left << std::setw(12) << stageName(static_cast<StartupStage>(i)) << std::right
+            << std::setw(8) << (stage.thread == s_main_thread ? "main" : "worker")
+            << std::setw(10) << (stage.begin - s_origin) * ms
+            << std::setw(10) << (stage.end - s_origin) * ms
+            << std::setw(10) << (stage.end - stage.begin) * ms << std::endl;
+        if(stage.end > last) last = stage.end;
+    }
+    out << "total: " << (last - s_origin) * ms << std::endl;
+    out.unsetf(std::ios::floatfield);
+    out.precision(precision);
+}
+
+StartupTask::StartupTask(StartupStage stage, const std::function<void()>& job)
+{
+    m_stage = stage;
+    m_job = job;
+    m_thread = SDL_CreateThread(taskMain, StartupTimeline::stageName(stage), this);
+    if(m_thread == nullptr) taskMain(this);
+}
+
+StartupTask::~StartupTask()
+{
+    join();
+}
+
+void StartupTask::join()
+{
+    if(m_thread != nullptr) SDL_WaitThread(m_thread, nullptr);
+    m_thread = nullptr;
+}
+
+int StartupTask::taskMain(void* data)
+{
+    StartupTask* task = static_cast<StartupTask*>(data);
+    StartupStageScope scope(task->m_stage);
+    task->m_job();
+    return 0;
+}
@@ -0,0 +1,116 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <ostream>
+
+/**
+ * Etapy uruchamiania programu.
+ */
+enum StartupStage
+{
+    SS_SDL_INIT,
+    SS_WINDOW,
+    SS_RENDERER,
+    SS_TEXTURE,
+    SS_FONT,
+    SS_SPRITES,
+    SS_LEVELS,
+    SS_UPLOAD,
+    SS_MENU,
+    SS_FIRST_FRAME,
+    SS_COUNT
+};
+
+/**
+ * @brief
+ * Klasa zapisuje czas rozpoczęcia i zakończenia każdego etapu uruchamiania programu oraz wątek, w którym etap był wykonywany.
+ * Każdy etap jest zapisywany tylko przez jeden wątek, a raport jest wypisywany po dołączeniu wszystkich wątków, więc zapis nie wymaga synchronizacji.
+ */
+class StartupTimeline
+{
+public:
+    /**
+     * Zapamiętanie chwili uruchomienia programu i wątku głównego; wywoływane w wątku głównym przed wszystkimi etapami.
+     */
+    static void start();
+    /**
+     * Zapisanie rozpoczęcia etapu.
+     * @param stage - etap
+     */
+    static void begin(StartupStage stage);
+    /**
+     * Zapisanie zakończenia etapu.
+     * @param stage - etap
+     */
+    static void end(StartupStage stage);
+    /**
+     * @param stage - etap
+     * @return krótka nazwa etapu
+     */
+    static const char* stageName(StartupStage stage);
+    /**
+     * Wypisanie początku, końca i czasu trwania każdego zakończonego etapu w milisekundach od @a StartupTimeline::start.
+     * @param out - strumień wyjściowy
+     */
+    static void report(std::ostream& out);
+};
+
+/**
+ * @brief
+ * Obiekt zapisuje etap trwający przez czas swojego życia.
+ */
+class StartupStageScope
+{
+public:
+    StartupStageScope(StartupStage stage)
+    {
+        m_stage = stage;
+        StartupTimeline::begin(stage);
+    }
+    ~StartupStageScope()
+    {
+        StartupTimeline::end(m_stage);
+    }
+
+private:
+    StartupStage m_stage;
+};
+
+/**
+ * @brief
+ * Klasa wykonuje jeden etap uruchamiania w osobnym wątku. Wątek jest dołączany funkcją @a StartupTask::join lub w destruktorze.
+ * Jeśli nie uda się stworzyć wątku, etap jest wykonywany od razu w wątku wywołującym.
+ */
+class StartupTask
+{
+public:
+    /**
+     * Uruchomienie etapu.
+     * @param stage - etap zapisywany w @a StartupTimeline
+     * @param job - praca etapu
+     */
+    StartupTask(StartupStage stage, const std::function<void()>& job);
+    ~StartupTask();
+    /**
+     * Oczekiwanie na zakończenie etapu.
+     */
+    void join();
+
+private:
+    StartupTask(const StartupTask&);
+    StartupTask& operator=(const StartupTask&);
+    /**
+     * Funkcja wątku wykonującego etap.
+     * @param data - wskaźnik na obiekt @a StartupTask
+     * @return kod zakończenia wątku
+     */
+    static int taskMain(void* data);
+
+    StartupStage m_stage;
+    std::function<void()> m_job;
+    SDL_Thread* m_thread;
+};
+
+#endif // STARTUPTIMELINE_H
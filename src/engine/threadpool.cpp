@@ -0,0 +1,103 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(unsigned threads_count)
+{
+    m_job = nullptr;
+    m_count = 0;
+    m_active = 0;
+    m_generation = 0;
+    m_quit = false;
+    SDL_AtomicSet(&m_next, 0);
+
+    m_mutex = SDL_CreateMutex();
+    m_work_cond = SDL_CreateCond();
+    m_done_cond = SDL_CreateCond();
+
+    //wątek wywołujący parallelFor ma numer 0, wątki robocze kolejne numery
+    if(threads_count > 1) m_workers.resize(threads_count - 1);
+    for(unsigned i = 0; i < m_workers.size(); i++)
+    {
+        m_workers.at(i).pool = this;
+        m_workers.at(i).index = i + 1;
+        SDL_Thread* thread = SDL_CreateThread(workerMain, "worker", &m_workers.at(i));
+        if(thread == nullptr) break;
+        m_threads.push_back(thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    SDL_LockMutex(m_mutex);
+    m_quit = true;
+    SDL_CondBroadcast(m_work_cond);
+    SDL_UnlockMutex(m_mutex);
+
+    for(auto thread : m_threads) SDL_WaitThread(thread, nullptr);
+    m_threads.clear();
+
+    SDL_DestroyCond(m_done_cond);
+    SDL_DestroyCond(m_work_cond);
+    SDL_DestroyMutex(m_mutex);
+}
+
+unsigned ThreadPool::size() const
+{
+    return m_threads.size() + 1;
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int, unsigned)>& job)
+{
+    if(m_threads.empty() || count <= 1)
+    {
+        for(int i = 0; i < count; i++) job(i, 0);
+        return;
+    }
+
+    SDL_LockMutex(m_mutex);
+    m_job = &job;
+    m_count = count;
+    SDL_AtomicSet(&m_next, 0);
+    m_active = m_threads.size();
+    m_generation++;
+    SDL_CondBroadcast(m_work_cond);
+    SDL_UnlockMutex(m_mutex);
+
+    runJob(0);
+
+    SDL_LockMutex(m_mutex);
+    while(m_active > 0) SDL_CondWait(m_done_cond, m_mutex);
+    m_job = nullptr;
+    SDL_UnlockMutex(m_mutex);
+}
+
+int ThreadPool::workerMain(void *data)
+{
+    Worker* worker = static_cast<Worker*>(data);
+    ThreadPool* pool = worker->pool;
+    unsigned generation = 0;
+
+    SDL_LockMutex(pool->m_mutex);
+    while(true)
+    {
+        while(!pool->m_quit && pool->m_generation == generation)
+            SDL_CondWait(pool->m_work_cond, pool->m_mutex);
+        if(pool->m_quit) break;
+        generation = pool->m_generation;
+        SDL_UnlockMutex(pool->m_mutex);
+
+        pool->runJob(worker->index);
+
+        SDL_LockMutex(pool->m_mutex);
+        pool->m_active--;
+        if(pool->m_active == 0) SDL_CondSignal(pool->m_done_cond);
+    }
+    SDL_UnlockMutex(pool->m_mutex);
+    return 0;
+}
+
+void ThreadPool::runJob(unsigned worker)
+{
+    int index;
+    while((index = SDL_AtomicAdd(&m_next, 1)) < m_count)
+        (*m_job)(index, worker);
+}
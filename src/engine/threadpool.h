@@ -0,0 +1,100 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief
+ * Klasa utrzymuje stałą pulę wątków roboczych wykorzystywanych do równoległego wykonywania niezależnych zadań.
+ * Wątki są tworzone raz przy inicjalizacji silnika i czekają na kolejne zadania, dzięki czemu rozdzielenie pracy w każdej klatce nie wymaga tworzenia wątków.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * Tworzenie puli.
+     * @param threads_count - łączna liczba wątków wykonujących zadania, wliczając wątek wywołujący @a ThreadPool::parallelFor; wartość 1 oznacza wykonanie sekwencyjne
+     */
+    ThreadPool(unsigned threads_count);
+    ~ThreadPool();
+
+    /**
+     * @return łączną liczbę wątków wykonujących zadania, wliczając wątek wywołujący
+     */
+    unsigned size() const;
+    /**
+     * Wykonanie zadania dla każdego indeksu z przedziału [0, count). Indeksy są rozdzielane dynamicznie pomiędzy wątki, a wątek wywołujący również bierze udział w pracy.
+     * Funkcja wraca dopiero po wykonaniu wszystkich indeksów. Kolejność wykonania indeksów nie jest określona.
+     * @param count - liczba indeksów
+     * @param job - zadanie wywoływane z numerem indeksu oraz numerem wątku z przedziału [0, size())
+     */
+    void parallelFor(int count, const std::function<void(int index, unsigned worker)>& job);
+
+private:
+    /**
+     * Pętla główna wątku roboczego.
+     * @param data - wskaźnik na strukturę @a Worker
+     * @return kod zakończenia wątku
+     */
+    static int workerMain(void* data);
+    /**
+     * Pobieranie kolejnych indeksów bieżącego zadania aż do ich wyczerpania.
+     * @param worker - numer wątku
+     */
+    void runJob(unsigned worker);
+
+    /**
+     * @brief Dane przekazywane do wątku roboczego.
+     */
+    struct Worker
+    {
+        ThreadPool* pool;
+        unsigned index;
+    };
+
+    /**
+     * Wątki robocze.
+     */
+    std::vector<SDL_Thread*> m_threads;
+    /**
+     * Dane wątków roboczych.
+     */
+    std::vector<Worker> m_workers;
+    SDL_mutex* m_mutex;
+    /**
+     * Sygnalizacja pojawienia się nowego zadania.
+     */
+    SDL_cond* m_work_cond;
+    /**
+     * Sygnalizacja zakończenia zadania przez wszystkie wątki robocze.
+     */
+    SDL_cond* m_done_cond;
+    /**
+     * Aktualnie wykonywane zadanie.
+     */
+    const std::function<void(int, unsigned)>* m_job;
+    /**
+     * Liczba indeksów bieżącego zadania.
+     */
+    int m_count;
+    /**
+     * Następny niepobrany indeks bieżącego zadania.
+     */
+    SDL_atomic_t m_next;
+    /**
+     * Liczba wątków roboczych, które jeszcze nie skończyły bieżącego zadania.
+     */
+    unsigned m_active;
+    /**
+     * Numer bieżącego zadania; zmiana budzi wątki robocze.
+     */
+    unsigned m_generation;
+    /**
+     * Zmienna informuje wątki robocze o zamykaniu puli.
+     */
+    bool m_quit;
+};
+
+#endif // THREADPOOL_H
@@ -10,9 +10,26 @@
 */
 
 #include "app.h"
+#include "appconfig.h"
+#include <cstdlib>
+#include <cstring>
 
 int main( int argc, char* args[] )
 {
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::strcmp(args[i], "--startup-report") == 0) AppConfig::startup_report = true;
+        else if(std::strcmp(args[i], "--hot-reload") == 0) AppConfig::level_hot_reload = true;
+        else if(std::strcmp(args[i], "--generate") == 0 && i + 1 < argc)
+        {
+            AppConfig::generated_levels = true;
+            AppConfig::generator_seed = std::strtoul(args[++i], nullptr, 10);
+        }
+        else if(std::strcmp(args[i], "--ai-budget") == 0 && i + 1 < argc)
+            AppConfig::ai_time_budget = std::strtoul(args[++i], nullptr, 10);
+        else if(std::strcmp(args[i], "--parallel-ai") == 0) AppConfig::parallel_ai_decisions = true;
+    }
+
     App app;
     app.run();
 
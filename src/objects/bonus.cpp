@@ -1,6 +1,8 @@
 #include "bonus.h"
 #include "../appconfig.h"
 
+ObjectPool<Bonus, 16> Bonus::pool;
+
 Bonus::Bonus()
     : Object(0, 0, ST_BONUS_STAR)
 {
@@ -31,3 +33,13 @@ void Bonus::update(Uint32 dt)
         m_show = true;
     else m_show = false;
 }
+
+void* Bonus::operator new(std::size_t size)
+{
+    return pool.allocate(size);
+}
+
+void Bonus::operator delete(void *ptr)
+{
+    pool.deallocate(ptr);
+}
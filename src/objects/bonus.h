@@ -2,6 +2,7 @@
 #define BONUS_H
 
 #include "object.h"
+#include "../engine/objectpool.h"
 
 /**
  * @brief Klasa zajumująca wyświetlaniem bonusu.
@@ -21,6 +22,18 @@ public:
      */
     Bonus(double x, double y, SpriteType type);
 
+    /**
+     * Przydział pamięci z puli bonusów.
+     * @param size - rozmiar obiektu
+     * @return wskaźnik na pamięć dla nowego obiektu
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Zwrócenie pamięci obiektu do puli.
+     * @param ptr - wskaźnik na pamięć obiektu
+     */
+    static void operator delete(void* ptr);
+
     /**
      * Funkcja rysująca bonus.
      */
@@ -31,6 +44,11 @@ public:
      * @param dt - czas od ostatniego wywołania funkcji
      */
     void update(Uint32 dt);
+    /**
+     * Pula pamięci bonusów; obiekty tworzone ponad jej pojemność trafiają na stertę.
+     */
+    static ObjectPool<Bonus, 16> pool;
+
 private:
     /**
      * Czas od stworzenie bonusu.
@@ -0,0 +1,253 @@
+#include "bulletstore.h"
+#include "../engine/engine.h"
+
+namespace
+{
+    /**
+     * Usunięcie elementu tablicy z przeniesieniem ostatniego na jego miejsce, tak jak w @a SlotMap::eraseAt.
+     */
+    template <class T>
+    void removeAt(std::vector<T>& values, unsigned index)
+    {
+        values.at(index) = values.back();
+        values.pop_back();
+    }
+}
+
+BulletStore::BulletStore()
+{
+    m_bullet_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_BULLET);
+    m_explosion_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_BULLET);
+}
+
+void BulletStore::reserve(unsigned count)
+{
+    m_flags.reserve(count);
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_velocity_x.reserve(count);
+    m_velocity_y.reserve(count);
+    m_rect_x.reserve(count);
+    m_rect_y.reserve(count);
+    m_direction.reserve(count);
+    m_frame.reserve(count);
+    m_frame_time.reserve(count);
+    m_impact_position.reserve(count);
+    m_impact_revision.reserve(count);
+}
+
+BulletStore::Handle BulletStore::insert(double x, double y, Direction direction, double speed)
+{
+    Handle handle = m_flags.insert(0);
+    if(handle == null_handle) return handle;
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_velocity_x.push_back(direction == D_RIGHT ? speed : direction == D_LEFT ? -speed : 0.0);
+    m_velocity_y.push_back(direction == D_DOWN ? speed : direction == D_UP ? -speed : 0.0);
+    m_rect_x.push_back(x);
+    m_rect_y.push_back(y);
+    m_direction.push_back(direction);
+    m_frame.push_back(0);
+    m_frame_time.push_back(0);
+    m_impact_position.push_back(0);
+    m_impact_revision.push_back(-1);
+    return handle;
+}
+
+void BulletStore::erase(Handle handle)
+{
+    int index = indexOf(handle);
+    if(index < 0) return;
+
+    removeAt(m_x, index);
+    removeAt(m_y, index);
+    removeAt(m_velocity_x, index);
+    removeAt(m_velocity_y, index);
+    removeAt(m_rect_x, index);
+    removeAt(m_rect_y, index);
+    removeAt(m_direction, index);
+    removeAt(m_frame, index);
+    removeAt(m_frame_time, index);
+    removeAt(m_impact_position, index);
+    removeAt(m_impact_revision, index);
+    m_flags.eraseAt(index);
+}
+
+void BulletStore::eraseFinished()
+{
+    for(unsigned i = 0; i < m_flags.size();)
+    {
+        if(m_flags.at(i) & BF_FINISHED) erase(m_flags.handleAt(i));
+        else i++;
+    }
+}
+
+void BulletStore::clear()
+{
+    while(m_flags.size() > 0) erase(m_flags.handleAt(m_flags.size() - 1));
+}
+
+int BulletStore::indexOf(Handle handle) const
+{
+    return m_flags.indexOf(handle);
+}
+
+unsigned BulletStore::size() const
+{
+    return m_flags.size();
+}
+
+void BulletStore::update(Uint32 dt)
+{
+    unsigned count = m_flags.size();
+    double time = dt;
+
+    //pętla bez rozgałęzień po ciągłych tablicach; pociski po zderzeniu mają zerową prędkość, więc stoją w miejscu
+    double* x = m_x.data();
+    double* y = m_y.data();
+    const double* velocity_x = m_velocity_x.data();
+    const double* velocity_y = m_velocity_y.data();
+    int* rect_x = m_rect_x.data();
+    int* rect_y = m_rect_y.data();
+    for(unsigned i = 0; i < count; i++)
+    {
+        x[i] += velocity_x[i] * time;
+        y[i] += velocity_y[i] * time;
+        rect_x[i] = static_cast<int>(x[i]);
+        rect_y[i] = static_cast<int>(y[i]);
+    }
+
+    if(m_explosion_sprite->frames_count <= 1) return;
+    for(unsigned i = 0; i < count; i++)
+    {
+        Uint8& flags = m_flags.at(i);
+        if(!(flags & BF_COLLIDE) || (flags & BF_FINISHED)) continue;
+
+        m_frame_time.at(i) += dt;
+        if(m_frame_time.at(i) > m_explosion_sprite->frame_duration)
+        {
+            m_frame_time.at(i) = 0;
+            m_frame.at(i)++;
+            if(m_frame.at(i) >= m_explosion_sprite->frames_count) flags |= BF_FINISHED;
+        }
+    }
+}
+
+void BulletStore::draw() const
+{
+    Renderer* renderer = Engine::getEngine().getRenderer();
+    const SDL_Rect& bullet = m_bullet_sprite->rect;
+    const SDL_Rect& explosion = m_explosion_sprite->rect;
+    for(unsigned i = 0; i < m_flags.size(); i++)
+    {
+        Uint8 flags = m_flags.at(i);
+        if(flags & BF_FINISHED) continue;
+
+        Direction direction = static_cast<Direction>(m_direction.at(i));
+        SDL_Rect src, dest;
+        if(!(flags & BF_COLLIDE))
+        {
+            //w locie pocisk ma jedną klatkę dla każdego kierunku
+            src = {bullet.x + direction * bullet.w, bullet.y, bullet.w, bullet.h};
+            dest = {m_rect_x.at(i), m_rect_y.at(i), bullet.w, bullet.h};
+        }
+        else
+        {
+            //wybuch jest środkowany na czole pocisku
+            double x = m_x.at(i), y = m_y.at(i);
+            switch(direction)
+            {
+            case D_UP:
+                dest.x = x + (bullet.w - explosion.w) / 2;
+                dest.y = y - explosion.h / 2;
+                break;
+            case D_RIGHT:
+                dest.x = x + bullet.w - explosion.w / 2;
+                dest.y = y + (bullet.h - explosion.h) / 2;
+                break;
+            case D_DOWN:
+                dest.x = x + (bullet.w - explosion.w) / 2;
+                dest.y = y + bullet.h - explosion.h / 2;
+                break;
+            case D_LEFT:
+                dest.x = x - explosion.w / 2;
+                dest.y = y + (bullet.h - explosion.h) / 2;
+                break;
+            }
+            dest.w = explosion.w;
+            dest.h = explosion.h;
+            src = {explosion.x, explosion.y + m_frame.at(i) * explosion.h, explosion.w, explosion.h};
+        }
+        renderer->drawObject(&src, &dest);
+    }
+}
+
+void BulletStore::destroy(unsigned index)
+{
+    Uint8& flags = m_flags.at(index);
+    if(flags & BF_COLLIDE) return; //zapobiega wielokrotnemu wywołaniu
+
+    flags |= BF_COLLIDE;
+    m_velocity_x.at(index) = 0.0;
+    m_velocity_y.at(index) = 0.0;
+    m_frame.at(index) = 0;
+    m_frame_time.at(index) = 0;
+}
+
+void BulletStore::setSpeed(unsigned index, double speed)
+{
+    if(m_flags.at(index) & BF_COLLIDE) return;
+    switch(m_direction.at(index))
+    {
+    case D_UP: m_velocity_y.at(index) = -speed; break;
+    case D_RIGHT: m_velocity_x.at(index) = speed; break;
+    case D_DOWN: m_velocity_y.at(index) = speed; break;
+    case D_LEFT: m_velocity_x.at(index) = -speed; break;
+    }
+}
+
+void BulletStore::setFlag(unsigned index, BulletFlag flag)
+{
+    m_flags.at(index) |= flag;
+}
+
+bool BulletStore::testFlag(unsigned index, BulletFlag flag) const
+{
+    return (m_flags.at(index) & flag) != 0;
+}
+
+Direction BulletStore::direction(unsigned index) const
+{
+    return static_cast<Direction>(m_direction.at(index));
+}
+
+SDL_Rect BulletStore::collisionRect(unsigned index) const
+{
+    return {m_rect_x.at(index), m_rect_y.at(index), m_bullet_sprite->rect.w, m_bullet_sprite->rect.h};
+}
+
+int BulletStore::impactPosition(unsigned index) const
+{
+    return m_impact_position.at(index);
+}
+
+int BulletStore::impactRevision(unsigned index) const
+{
+    return m_impact_revision.at(index);
+}
+
+void BulletStore::setImpact(unsigned index, int position, int revision)
+{
+    m_impact_position.at(index) = position;
+    m_impact_revision.at(index) = revision;
+}
+
+int BulletStore::width() const
+{
+    return m_bullet_sprite->rect.w;
+}
+
+int BulletStore::height() const
+{
+    return m_bullet_sprite->rect.h;
+}
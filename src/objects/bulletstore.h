@@ -0,0 +1,141 @@
+#ifndef BULLETSTORE_H
+#define BULLETSTORE_H
+
+#include "../type.h"
+#include "../engine/slotmap.h"
+#include "../engine/spriteconfig.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Pociski wszystkich czołgów jednej rozgrywki przechowywane jako struktura tablic: każda cecha pocisku (położenie, prędkość w osiach, kierunek, flagi, klatka wybuchu, przewidywane trafienie) ma osobną ciągłą tablicę.
+ * Ruch wszystkich pocisków jest liczony jedną pętlą po tablicach położeń i prędkości, którą kompilator może zwektoryzować; rysowanie i wykrywanie kolizji odczytują te same tablice.
+ * Pociski są wskazywane uchwytami, a ich położenie w tablicach (indeks) jest ważne do najbliższego wywołania @a BulletStore::eraseFinished lub @a BulletStore::erase.
+ */
+class BulletStore
+{
+public:
+    typedef SlotMap<Uint8>::Handle Handle;
+
+    /**
+     * Flagi stanu pocisku.
+     */
+    enum BulletFlag
+    {
+        BF_COLLIDE = 1, ///< pocisk się z czymś zderzył i trwa animacja wybuchu
+        BF_INCREASED_DAMAGE = 2, ///< zwiększone obrażenia pozwalają niszczyć kamienny mur oraz krzaki
+        BF_FINISHED = 4 ///< animacja wybuchu się skończyła i pocisk czeka na usunięcie
+    };
+
+    /**
+     * Uchwyt, który nigdy nie wskazuje na pocisk.
+     */
+    static const Handle null_handle = SlotMap<Uint8>::null_handle;
+
+    BulletStore();
+
+    /**
+     * Rezerwacja pamięci na podaną liczbę pocisków, aby kolejne wystrzały nie odwoływały się do sterty.
+     * @param count - liczba pocisków
+     */
+    void reserve(unsigned count);
+    /**
+     * Dodanie lecącego pocisku.
+     * @param x - pozycja pozioma lewego górnego rogu
+     * @param y - pozycja pionowa lewego górnego rogu
+     * @param direction - kierunek lotu
+     * @param speed - prędkość lotu
+     * @return uchwyt pocisku
+     */
+    Handle insert(double x, double y, Direction direction, double speed);
+    /**
+     * Usunięcie pocisku wskazanego uchwytem; na jego miejsce w tablicach trafia ostatni pocisk.
+     * @param handle - uchwyt pocisku
+     */
+    void erase(Handle handle);
+    /**
+     * Usunięcie wszystkich pocisków, których animacja wybuchu się skończyła.
+     */
+    void eraseFinished();
+    /**
+     * Usunięcie wszystkich pocisków; wszystkie wydane uchwyty przestają być ważne.
+     */
+    void clear();
+    /**
+     * @param handle - uchwyt pocisku
+     * @return położenie pocisku w tablicach lub -1 jeśli uchwyt nie jest ważny
+     */
+    int indexOf(Handle handle) const;
+    unsigned size() const;
+
+    /**
+     * Ruch lecących pocisków i animacja wybuchów.
+     * @param dt - czas od ostatniego wywołania funkcji
+     */
+    void update(Uint32 dt);
+    /**
+     * Rysowanie lecących pocisków i wybuchów.
+     */
+    void draw() const;
+
+    /**
+     * Włączenie animacji wybuchu pocisku; kolejne wywołania nic nie zmieniają.
+     * @param index - położenie pocisku w tablicach
+     */
+    void destroy(unsigned index);
+    void setSpeed(unsigned index, double speed);
+    void setFlag(unsigned index, BulletFlag flag);
+    bool testFlag(unsigned index, BulletFlag flag) const;
+    Direction direction(unsigned index) const;
+    /**
+     * @param index - położenie pocisku w tablicach
+     * @return prostokąt kolizji pocisku; po zderzeniu pozostaje w miejscu zderzenia
+     */
+    SDL_Rect collisionRect(unsigned index) const;
+    /**
+     * Współrzędna w osi ruchu pocisku, po przekroczeniu której krawędź pocisku może zetknąć się z przeszkodą na mapie, granicą mapy lub orzełkiem.
+     * @see Game::predictBulletImpact
+     */
+    int impactPosition(unsigned index) const;
+    /**
+     * Wersja mapy, dla której wyznaczono @a impactPosition; wartość -1 oznacza brak przewidywania.
+     */
+    int impactRevision(unsigned index) const;
+    void setImpact(unsigned index, int position, int revision);
+
+    /**
+     * Wymiary lecącego pocisku.
+     */
+    int width() const;
+    int height() const;
+
+private:
+    /**
+     * Flagi pocisków; kontener nadaje uchwyty i wyznacza kolejność wszystkich pozostałych tablic.
+     */
+    SlotMap<Uint8> m_flags;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    /**
+     * Prędkość w osiach ze znakiem kierunku; zerowa po zderzeniu.
+     */
+    std::vector<double> m_velocity_x;
+    std::vector<double> m_velocity_y;
+    /**
+     * Położenie prostokąta kolizji, czyli położenie pocisku obcięte do pełnych pikseli.
+     */
+    std::vector<int> m_rect_x;
+    std::vector<int> m_rect_y;
+    std::vector<Uint8> m_direction;
+    std::vector<Uint8> m_frame;
+    std::vector<Uint32> m_frame_time;
+    std::vector<int> m_impact_position;
+    std::vector<int> m_impact_revision;
+
+    const SpriteData* m_bullet_sprite;
+    const SpriteData* m_explosion_sprite;
+};
+
+#endif // BULLETSTORE_H
@@ -1,13 +1,16 @@
 #include "enemy.h"
 #include "../appconfig.h"
 #include <stdlib.h>
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 
-Enemy::Enemy()
-    : Tank(AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A)
+ObjectPool<Enemy, 32> Enemy::pool;
+
+Enemy::Enemy(TankStore* store)
+    : Tank(store, AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A)
 {
-    direction = D_DOWN;
+    m_store->setDirection(storeIndex(), D_DOWN);
     m_direction_time = 0;
     m_keep_direction_time = 100;
 
@@ -16,11 +19,12 @@ Enemy::Enemy()
 
     m_fire_time = 0;
     m_reload_time = 100;
+    m_pending_decisions = 0;
+    m_random = Random(rand());
     lives_count = 1;
 
     m_bullet_max_size = 1;
-
-    m_frozen_time = 0;
+    bullets.reserve(m_bullet_max_size);
 
     if(type == ST_TANK_B)
         default_speed = AppConfig::tank_default_speed * 1.3;
@@ -28,14 +32,17 @@ Enemy::Enemy()
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1};
+    target_player = SlotMap<Player*>::null_handle;
+    target_field = nullptr;
+    line_of_sight = nullptr;
 
     respawn();
 }
 
-Enemy::Enemy(double x, double y, SpriteType type)
-    : Tank(x, y, type)
+Enemy::Enemy(TankStore* store, double x, double y, SpriteType type)
+    : Tank(store, x, y, type)
 {
-    direction = D_DOWN;
+    m_store->setDirection(storeIndex(), D_DOWN);
     m_direction_time = 0;
     m_keep_direction_time = 100;
 
@@ -44,11 +51,12 @@ Enemy::Enemy(double x, double y, SpriteType type)
 
     m_fire_time = 0;
     m_reload_time = 100;
+    m_pending_decisions = 0;
+    m_random = Random(rand());
     lives_count = 1;
 
     m_bullet_max_size = 1;
-
-    m_frozen_time = 0;
+    bullets.reserve(m_bullet_max_size);
 
     if(type == ST_TANK_B)
         default_speed = AppConfig::tank_default_speed * 1.3;
@@ -56,6 +64,9 @@ Enemy::Enemy(double x, double y, SpriteType type)
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1};
+    target_player = SlotMap<Player*>::null_handle;
+    target_field = nullptr;
+    line_of_sight = nullptr;
 
     respawn();
 }
@@ -83,89 +94,181 @@ void Enemy::update(Uint32 dt)
     if(to_erase) return;
     Tank::update(dt);
 
+    int index = storeIndex();
+    const SpriteData* sprite = m_store->sprite(index);
+    int frame = m_store->frame(index);
     if(testFlag(TSF_LIFE))
     {
         if(testFlag(TSF_BONUS))
-            src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction) - 4, m_current_frame);
+            src_rect = moveRect(sprite->rect, facing() - 4, frame);
         else
-            src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction) + (lives_count -1) * 4, m_current_frame);
+            src_rect = moveRect(sprite->rect, facing() + (lives_count -1) * 4, frame);
     }
     else
-        src_rect = moveRect(m_sprite->rect, 0, m_current_frame);
+        src_rect = moveRect(sprite->rect, 0, frame);
 
     if(testFlag(TSF_FROZEN)) return;
 
     m_direction_time += dt;
     m_speed_time += dt;
     m_fire_time += dt;
-    if(m_direction_time > m_keep_direction_time)
+    if(m_direction_time > m_keep_direction_time) m_pending_decisions |= DECISION_STEER;
+    if(m_speed_time > m_try_to_go_time) m_pending_decisions |= DECISION_GO;
+    if(m_fire_time > m_reload_time) m_pending_decisions |= DECISION_FIRE;
+
+    setStopped(false);
+}
+
+void Enemy::plan(EnemyIntent& intent) const
+{
+    intent.steer = false;
+    intent.direction = direction();
+    intent.go = false;
+    intent.reload = false;
+    intent.fire = false;
+    intent.random = m_random;
+    if(to_erase || testFlag(TSF_FROZEN)) return;
+
+    Random& random = intent.random;
+    if(m_pending_decisions & DECISION_STEER)
     {
-        m_direction_time = 0;
-        m_keep_direction_time = rand() % 800 + 100;
+        intent.steer = true;
+        intent.keep_direction_time = random.below(800) + 100;
 
-        float p = static_cast<float>(rand()) / RAND_MAX;
+        float p = random.unit();
 
-        if(p < (type == ST_TANK_A ? 0.8 : 0.5) && target_position.x > 0 && target_position.y > 0)
+        Direction field_direction;
+        if(p < (type == ST_TANK_A ? 0.8 : 0.5) && target_field != nullptr && target_field->direction(posX(), posY(), field_direction))
+        {
+            //droga wyznaczona przez pole odległości omija kamienie i wodę
+            intent.direction = field_direction;
+        }
+        else if(p < (type == ST_TANK_A ? 0.8 : 0.5) && target_position.x > 0 && target_position.y > 0)
         {
             int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
             int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
 
-            p = static_cast<float>(rand()) / RAND_MAX;
+            p = random.unit();
 
             if(abs(dx) > abs(dy))
-                setDirection(p < 0.7 ? (dx < 0 ? D_LEFT : D_RIGHT) : (dy < 0 ? D_UP : D_DOWN));
+                intent.direction = p < 0.7 ? (dx < 0 ? D_LEFT : D_RIGHT) : (dy < 0 ? D_UP : D_DOWN);
             else
-                setDirection(p < 0.7 ? (dy < 0 ? D_UP : D_DOWN) : (dx < 0 ? D_LEFT : D_RIGHT));
+                intent.direction = p < 0.7 ? (dy < 0 ? D_UP : D_DOWN) : (dx < 0 ? D_LEFT : D_RIGHT);
         }
         else
-            setDirection(static_cast<Direction>(rand() % 4));
+            intent.direction = static_cast<Direction>(random.below(4));
     }
-    if(m_speed_time > m_try_to_go_time)
+    if(m_pending_decisions & DECISION_GO)
     {
-        m_speed_time = 0;
-        m_try_to_go_time = rand() % 300;
-        speed = default_speed;
+        intent.go = true;
+        intent.try_to_go_time = random.below(300);
     }
-    if(m_fire_time > m_reload_time)
+    if(m_pending_decisions & DECISION_FIRE)
     {
-        m_fire_time = 0;
+        //strzał pada w kierunku wybranym w tej samej decyzji
+        Direction d = intent.direction;
+        intent.reload = true;
         if(type == ST_TANK_D)
         {
-            m_reload_time = rand() % 400;
+            intent.reload_time = random.below(400);
             int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
             int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
 
-            if(stop) fire();
+            if(stopped())
+                intent.fire = shotUseful(d);
             else
-                switch (direction)
+                switch (d)
                 {
                 case D_UP:
-                    if(dy < 0 && abs(dx) < dest_rect.w) fire();
+                    intent.fire = dy < 0 && abs(dx) < dest_rect.w && shotUseful(d);
                     break;
                 case D_RIGHT:
-                    if(dx > 0 && abs(dy) < dest_rect.h) fire();
+                    intent.fire = dx > 0 && abs(dy) < dest_rect.h && shotUseful(d);
                     break;
                 case D_DOWN:
-                    if(dy > 0 && abs(dx) < dest_rect.w) fire();
+                    intent.fire = dy > 0 && abs(dx) < dest_rect.w && shotUseful(d);
                     break;
                 case D_LEFT:
-                    if(dx < 0 && abs(dy) < dest_rect.h) fire();
+                    intent.fire = dx < 0 && abs(dy) < dest_rect.h && shotUseful(d);
                     break;
                 }
         }
         else if(type == ST_TANK_C)
         {
-            m_reload_time = rand() % 800;
-            fire();
+            intent.reload_time = random.below(800);
+            intent.fire = shotUseful(d);
         }
         else
         {
-            m_reload_time = rand() % 1000;
-            fire();
+            intent.reload_time = random.below(1000);
+            intent.fire = shotUseful(d);
         }
     }
+}
+
+void Enemy::apply(const EnemyIntent& intent)
+{
+    m_random = intent.random;
+    if(intent.steer)
+    {
+        m_direction_time = 0;
+        m_keep_direction_time = intent.keep_direction_time;
+        setDirection(intent.direction);
+    }
+    if(intent.go)
+    {
+        m_speed_time = 0;
+        m_try_to_go_time = intent.try_to_go_time;
+        setSpeed(default_speed);
+    }
+    if(intent.reload)
+    {
+        m_fire_time = 0;
+        m_reload_time = intent.reload_time;
+        if(intent.fire) fire();
+    }
+    m_pending_decisions = 0;
+}
+
+bool Enemy::decisionPending() const
+{
+    return m_pending_decisions != 0 && !to_erase && !testFlag(TSF_FROZEN);
+}
+
+bool Enemy::steeringPending() const
+{
+    return (m_pending_decisions & DECISION_STEER) != 0;
+}
+
+Uint32 Enemy::decisionDelay() const
+{
+    Uint32 delay = 0;
+    if(m_pending_decisions & DECISION_STEER) delay = std::max(delay, m_direction_time - m_keep_direction_time);
+    if(m_pending_decisions & DECISION_GO) delay = std::max(delay, m_speed_time - m_try_to_go_time);
+    if(m_pending_decisions & DECISION_FIRE) delay = std::max(delay, m_fire_time - m_reload_time);
+    return delay;
+}
+
+bool Enemy::shotUseful(Direction direction) const
+{
+    if(line_of_sight == nullptr) return true;
+
+    int bullet_width = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_BULLET)->rect.w;
+    int block_distance;
+    Uint8 block = line_of_sight->cast(dest_rect, bullet_width, direction, block_distance);
+    if(block == ST_BRICK_WALL) return true;
 
-    stop = false;
+    //cel ma rozmiar czołgu, a target_position wskazuje jego środek
+    if(target_position.x < 0 || target_position.y < 0) return false;
+    int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
+    int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
+    bool vertical = direction == D_UP || direction == D_DOWN;
+    int across = vertical ? abs(dx) : abs(dy);
+    int along = direction == D_UP ? -dy : direction == D_DOWN ? dy : direction == D_LEFT ? -dx : dx;
+    int size = vertical ? dest_rect.h : dest_rect.w;
+    //odległość od boku czołgu do bliższego boku celu
+    int target_distance = along - size;
+    return along > 0 && across < (vertical ? dest_rect.w : dest_rect.h) / 2 + bullet_width / 2 && target_distance <= block_distance;
 }
 
 void Enemy::destroy()
@@ -184,3 +287,13 @@ unsigned Enemy::scoreForHit()
     if(lives_count > 0) return 50;
     return 100;
 }
+
+void* Enemy::operator new(std::size_t size)
+{
+    return pool.allocate(size);
+}
+
+void Enemy::operator delete(void *ptr)
+{
+    pool.deallocate(ptr);
+}
@@ -2,6 +2,44 @@
 #define ENEMY_H
 
 #include "tank.h"
+#include "flowfield.h"
+#include "lineofsight.h"
+#include "../engine/objectpool.h"
+#include "../engine/random.h"
+#include "../engine/slotmap.h"
+
+class Player;
+
+/**
+ * @brief Zamiary przeciwnika wyznaczone przez @a Enemy::plan i wykonywane przez @a Enemy::apply.
+ */
+struct EnemyIntent
+{
+    /**
+     * Zmienna mówi czy czołg wybrał kierunek jazdy @a direction na czas @a keep_direction_time.
+     */
+    bool steer;
+    Direction direction;
+    Uint32 keep_direction_time;
+    /**
+     * Zmienna mówi czy czołg wznawia jazdę z prędkością nominalną; kolejna próba nastąpi po @a try_to_go_time.
+     */
+    bool go;
+    Uint32 try_to_go_time;
+    /**
+     * Zmienna mówi czy czołg rozważył wystrzał; kolejna próba nastąpi po @a reload_time.
+     */
+    bool reload;
+    Uint32 reload_time;
+    /**
+     * Zmienna mówi czy czołg strzela.
+     */
+    bool fire;
+    /**
+     * Stan generatora liczb losowych czołgu po losowaniach decyzji.
+     */
+    Random random;
+};
 
 /**
  * @brief Klasa zajmująca się ruchami wrogich czołgów.
@@ -11,26 +49,65 @@ class Enemy : public Tank
 public:
     /**
      * Tworzenie przeciwnika w pierwszym z położeń wrogów.
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @see AppConfig::enemy_starting_point
      */
-    Enemy();
+    Enemy(TankStore* store);
     /**
      * Tworzenie przeciwnika
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @param x - pozycja początkowa pozioma
      * @param y - pozycja początkowa pionowa
      * @param type - typ czołgu przeciwnika
      */
-    Enemy(double x, double y, SpriteType type);
+    Enemy(TankStore* store, double x, double y, SpriteType type);
+
+    /**
+     * Przydział pamięci z puli czołgów przeciwników.
+     * @param size - rozmiar obiektu
+     * @return wskaźnik na pamięć dla nowego obiektu
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Zwrócenie pamięci obiektu do puli.
+     * @param ptr - wskaźnik na pamięć obiektu
+     */
+    static void operator delete(void* ptr);
 
     /**
      * Funkcja rysuje czołg przeciwnika i jeżeli jest ustawiona flaga @a AppConfig::show_enemy_target to rysuję linią łączącą czołg z jego celem.
      */
     void draw();
     /**
-     * Funkcja uaktualnia położenie czołgu oraz decyduje o kirunku i czasie kolejnego wystrzału w zależności od typy wroga.
+     * Funkcja uaktualnia położenie czołgu i liczniki czasu oraz zgłasza, że czołg powinien wybrać nowy kierunek jazdy, wznowić jazdę lub spróbować wystrzału.
+     * Same decyzje podejmują @a Enemy::plan i @a Enemy::apply wywoływane przez grę w kolejności ustalonej przez @a AiScheduler.
      * @param dt - czas od ostatniego wywołania funkcji
      */
     void update(Uint32 dt);
+    /**
+     * Wyznaczenie oczekujących decyzji: kierunku jazdy i czasu jego utrzymania, wznowienia jazdy oraz wystrzału w zależności od typu wroga.
+     * Funkcja nie zmienia stanu gry ani czołgu i losuje tylko generatorem czołgu, więc może być wywoływana równocześnie dla wielu przeciwników;
+     * odczytuje stan czołgu, @a target_position, @a target_field i @a line_of_sight, które w tym czasie nie mogą się zmieniać.
+     * @param intent - zamiary czołgu
+     */
+    void plan(EnemyIntent& intent) const;
+    /**
+     * Wykonanie zamiarów wyznaczonych przez @a Enemy::plan i usunięcie oczekujących decyzji.
+     * @param intent - zamiary czołgu
+     */
+    void apply(const EnemyIntent& intent);
+    /**
+     * @return true jeśli czołg czeka na podjęcie decyzji przez @a Enemy::plan
+     */
+    bool decisionPending() const;
+    /**
+     * @return true jeśli wśród oczekujących decyzji jest wybór kierunku jazdy; cel należy wybrać przed wywołaniem @a Enemy::plan
+     */
+    bool steeringPending() const;
+    /**
+     * @return czas w milisekundach, o jaki najstarsza oczekująca decyzja jest spóźniona
+     */
+    Uint32 decisionDelay() const;
     /**
      * Zmniejszczenie poziomu pancerza o 1. Jeżeli poziom pancerza dojdze do zera następuje wybuch (zniszczenie) czołgu.
      */
@@ -45,8 +122,44 @@ public:
      * Pozycja do jakiej kieruje się czołg przeciwnika.
      */
     SDL_Point target_position;
+    /**
+     * Uchwyt gracza, do którego kieruje się czołg, w zbiorze graczy gry; @a SlotMap::null_handle oznacza orzełka.
+     * Cel nie został jeszcze wybrany, dopóki @a target_field jest nullptr; @a target_position jest środkiem celu.
+     */
+    SlotMap<Player*>::Handle target_player;
+    /**
+     * Pole odległości do celu, według którego czołg wybiera kierunek jazdy, lub nullptr; ustawiane przez grę razem z @a target_position.
+     */
+    const FlowField* target_field;
+    /**
+     * Przeszkody na liniach strzału lub nullptr; jeśli są podane, czołg strzela tylko wtedy, gdy pocisk może trafić cel lub zniszczyć murek.
+     */
+    const LineOfSight* line_of_sight;
+
+    /**
+     * Pula pamięci czołgów przeciwników; obiekty tworzone ponad jej pojemność trafiają na stertę.
+     */
+    static ObjectPool<Enemy, 32> pool;
 
 private:
+    /**
+     * Bity decyzji oczekujących na @a Enemy::decide.
+     */
+    enum Decision
+    {
+        DECISION_STEER = 1 << 0,
+        DECISION_GO = 1 << 1,
+        DECISION_FIRE = 1 << 2
+    };
+
+    /**
+     * Sprawdzenie, czy pocisk wystrzelony w podanym kierunku doleci do celu przed pierwszą przeszkodą albo trafi w murek, otwierając drogę.
+     * Strzał w kamień lub w granicę mapy jest pomijany, bo przeciwnik ma tylko jeden pocisk.
+     * @param direction - kierunek strzału
+     * @return true jeśli warto strzelić
+     */
+    bool shotUseful(Direction direction) const;
+
     /**
      * Czas od ostatniej zmiany kierunku.
      */
@@ -73,6 +186,14 @@ private:
      * Czas po jakim nastąpi próba kolejnego wystrzału.
      */
     Uint32 m_reload_time;
+    /**
+     * Oczekujące decyzje (bity @a Decision).
+     */
+    Uint8 m_pending_decisions;
+    /**
+     * Generator liczb losowych decyzji czołgu; ziarno pochodzi z rand() przy tworzeniu czołgu, więc przebieg gry zależy tylko od ziarna rand(), a nie od liczby wątków.
+     */
+    Random m_random;
 };
 
 #endif // ENEMY_H
@@ -0,0 +1,208 @@
+#include "flowfield.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+/**
+ * Liczba kubełków odległości; koszt wjazdu nigdy nie przekracza @a FlowField::brick_cost, więc kubełki mogą być używane cyklicznie.
+ */
+static const int buckets_count = FlowField::brick_cost + 1;
+
+/**
+ * Koszt pola mapy nieprzejezdnego; większy od pozostałych kosztów, aby położenie z takim polem było nieprzejezdne.
+ */
+static const Uint8 blocked = 0xFF;
+
+const Uint16 FlowField::brick_cost;
+const Uint16 FlowField::unreachable;
+
+FlowField::FlowField()
+{
+    m_width = 0;
+    m_height = 0;
+    m_goal = {-1, -1};
+    m_buckets.resize(buckets_count);
+}
+
+void FlowField::build(const std::vector<const Tile*>& rows, int columns_count, SDL_Point goal)
+{
+    m_width = std::max(columns_count - 1, 0);
+    m_height = std::max(static_cast<int>(rows.size()) - 1, 0);
+    m_goal = goal;
+    m_cost.resize(m_width * m_height);
+    m_distance.assign(m_width * m_height, unreachable);
+    m_queued.assign(m_width * m_height, 0);
+    //koszt wjazdu na każde pole mapy, a z niego koszt wjazdu na położenie jako największy z jego czterech pól
+    reserve(rows.size(), columns_count);
+    m_cells.resize(m_width ? (m_width + 1) * (m_height + 1) : 0);
+    for(int y = 0; y <= m_height && m_width; y++)
+        for(int x = 0; x <= m_width; x++)
+            m_cells[y * (m_width + 1) + x] = cellCost(rows[y][x]);
+    for(int y = 0; y < m_height; y++)
+    {
+        const Uint8* top = &m_cells[y * (m_width + 1)];
+        const Uint8* bottom = top + m_width + 1;
+        for(int x = 0; x < m_width; x++)
+        {
+            Uint8 cost = std::max(std::max(top[x], top[x + 1]), std::max(bottom[x], bottom[x + 1]));
+            m_cost[y * m_width + x] = cost == blocked ? 0 : cost;
+        }
+    }
+
+    if(goal.x < 0 || goal.y < 0 || goal.x >= m_width || goal.y >= m_height) return;
+    int start = goal.y * m_width + goal.x;
+    if(m_cost[start] == 0) return;
+
+    //odległość do celu liczona wstecz: z położenia p do sąsiada q odległość rośnie o koszt wjazdu na p
+    m_distance[start] = 0;
+    m_buckets[0].push_back(start);
+    unsigned pending = 1;
+    for(unsigned current = 0; pending > 0; current++)
+    {
+        std::vector<int>& bucket = m_buckets[current % buckets_count];
+        for(std::size_t k = 0; k < bucket.size(); k++)
+        {
+            int p = bucket[k];
+            pending--;
+            if(m_distance[p] != current) continue; //położenie wcześniej osiągnięto krótszą drogą
+
+            int x = p % m_width, y = p / m_width;
+            unsigned next = current + m_cost[p];
+            const int neighbours[] = {x > 0 ? p - 1 : -1, x + 1 < m_width ? p + 1 : -1, y > 0 ? p - m_width : -1, y + 1 < m_height ? p + m_width : -1};
+            for(int q : neighbours)
+            {
+                if(q < 0 || m_cost[q] == 0 || m_distance[q] <= next) continue;
+                m_distance[q] = next;
+                m_buckets[next % buckets_count].push_back(q);
+                pending++;
+            }
+        }
+        bucket.clear();
+    }
+}
+
+void FlowField::reserve(int rows_count, int columns_count)
+{
+    int positions_count = std::max(columns_count - 1, 0) * std::max(rows_count - 1, 0);
+    m_cost.reserve(positions_count);
+    m_distance.reserve(positions_count);
+    m_queued.reserve(positions_count);
+    m_cells.reserve(rows_count * columns_count);
+    //położenie trafia do kubełka zwykle raz, a do kolejki co najwyżej raz naraz, więc kolejne przeliczenia i poprawki korzystają z tej samej pamięci
+    for(auto& bucket : m_buckets) bucket.reserve(positions_count);
+    m_queue.reserve(positions_count);
+}
+
+void FlowField::update(const std::vector<const Tile*>& rows, int columns_count, int row, int column)
+{
+    if(m_goal.x < 0) return;
+
+    for(int y = std::max(row - 1, 0); y <= row && y < m_height; y++)
+    {
+        for(int x = std::max(column - 1, 0); x <= column && x < m_width; x++)
+        {
+            int p = y * m_width + x;
+            Uint8 cost = footprintCost(rows, x, y);
+            if(cost == m_cost[p]) continue;
+            if(m_cost[p] != 0 && (cost == 0 || cost > m_cost[p]))
+            {
+                //przybyło przeszkód - odległości mogą tylko rosnąć, co wymaga pełnego przeliczenia
+                m_queue.clear();
+                build(rows, columns_count, m_goal);
+                return;
+            }
+
+            m_cost[p] = cost;
+            if(m_distance[p] == unreachable)
+            {
+                //położenie stało się przejezdne - odległość wyznaczamy z sąsiadów
+                const int neighbours[] = {x > 0 ? p - 1 : -1, x + 1 < m_width ? p + 1 : -1, y > 0 ? p - m_width : -1, y + 1 < m_height ? p + m_width : -1};
+                for(int q : neighbours)
+                    if(q >= 0 && m_cost[q] != 0 && m_distance[q] != unreachable)
+                        m_distance[p] = std::min<unsigned>(m_distance[p], m_distance[q] + m_cost[q]);
+            }
+            //tańszy wjazd na p skraca drogę jego sąsiadom
+            if(m_distance[p] != unreachable) m_queue.push_back(p);
+        }
+    }
+    propagate();
+}
+
+void FlowField::propagate()
+{
+    //kolejka cykliczna bez powtórzeń: położenie już czekające w kolejce nie jest dodawane ponownie, więc wystarcza miejsce na wszystkie położenia
+    std::size_t capacity = m_distance.size();
+    std::size_t count = m_queue.size();
+    for(int p : m_queue) m_queued[p] = 1;
+    m_queue.resize(capacity);
+    for(std::size_t head = 0; count > 0; head = (head + 1) % capacity, count--)
+    {
+        int p = m_queue[head];
+        m_queued[p] = 0;
+        int x = p % m_width, y = p / m_width;
+        unsigned next = m_distance[p] + m_cost[p];
+        const int neighbours[] = {x > 0 ? p - 1 : -1, x + 1 < m_width ? p + 1 : -1, y > 0 ? p - m_width : -1, y + 1 < m_height ? p + m_width : -1};
+        for(int q : neighbours)
+        {
+            if(q < 0 || m_cost[q] == 0 || m_distance[q] <= next) continue;
+            m_distance[q] = next;
+            if(m_queued[q]) continue;
+            m_queued[q] = 1;
+            m_queue[(head + count) % capacity] = q;
+            count++;
+        }
+    }
+    m_queue.clear();
+}
+
+void FlowField::clear()
+{
+    m_goal = {-1, -1};
+}
+
+SDL_Point FlowField::goal() const
+{
+    return m_goal;
+}
+
+bool FlowField::direction(double x, double y, Direction& direction) const
+{
+    if(m_goal.x < 0) return false;
+    SDL_Point footprint = footprintAt(x, y);
+    int fx = std::min(std::max(footprint.x, 0), m_width - 1);
+    int fy = std::min(std::max(footprint.y, 0), m_height - 1);
+    int p = fy * m_width + fx;
+    if(m_distance[p] == 0 || m_distance[p] == unreachable) return false;
+
+    //kolejność sąsiadów odpowiada wartościom Direction
+    const int neighbours[] = {fy > 0 ? p - m_width : -1, fx + 1 < m_width ? p + 1 : -1, fy + 1 < m_height ? p + m_width : -1, fx > 0 ? p - 1 : -1};
+    unsigned best = unreachable;
+    for(int d = 0; d < 4; d++)
+    {
+        int q = neighbours[d];
+        if(q < 0 || m_cost[q] == 0 || m_distance[q] == unreachable) continue;
+        unsigned distance = m_distance[q] + m_cost[q];
+        if(distance < best)
+        {
+            best = distance;
+            direction = static_cast<Direction>(d);
+        }
+    }
+    return best != unreachable;
+}
+
+SDL_Point FlowField::footprintAt(double x, double y)
+{
+    return {static_cast<int>((x + AppConfig::tile_rect.w / 2) / AppConfig::tile_rect.w), static_cast<int>((y + AppConfig::tile_rect.h / 2) / AppConfig::tile_rect.h)};
+}
+
+Uint8 FlowField::cellCost(const Tile& tile)
+{
+    if(tile.type == ST_STONE_WALL || tile.type == ST_WATER) return blocked;
+    return tile.type == ST_BRICK_WALL ? brick_cost : 1;
+}
+
+Uint8 FlowField::footprintCost(const std::vector<const Tile*>& rows, int x, int y)
+{
+    Uint8 cost = std::max(std::max(cellCost(rows[y][x]), cellCost(rows[y][x + 1])), std::max(cellCost(rows[y + 1][x]), cellCost(rows[y + 1][x + 1])));
+    return cost == blocked ? 0 : cost;
+}
@@ -0,0 +1,118 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "tile.h"
+#include <vector>
+
+/**
+ * @brief
+ * Pole odległości do celu (orzełka lub gracza) wyznaczane na mapie położeń czołgu. Czołg zajmuje obszar 2x2 pola, więc położeniem jest lewe górne pole czołgu.
+ * Wjazd na położenie bez przeszkód kosztuje 1, a na położenie z murkiem @a FlowField::brick_cost, bo murek trzeba najpierw zestrzelić; kamienie i woda są nieprzejezdne.
+ * Po zniszczeniu przeszkody pole jest poprawiane tylko wokół zmienionego pola mapy (@a FlowField::update), a pełne przeliczenie jest potrzebne jedynie wtedy, gdy przeszkód przybywa.
+ */
+class FlowField
+{
+public:
+    /**
+     * Koszt wjazdu na położenie, w którym czołg zachodzi na murek.
+     */
+    static const Uint16 brick_cost = 4;
+    /**
+     * Odległość położeń, z których nie da się dojechać do celu.
+     */
+    static const Uint16 unreachable = 0xFFFF;
+
+    FlowField();
+
+    /**
+     * Pełne wyznaczenie pola odległości metodą Diala (przeszukiwanie wszerz z kubełkami dla kosztów 1 i @a FlowField::brick_cost).
+     * @param rows - wiersze mapy
+     * @param columns_count - liczba kolumn mapy
+     * @param goal - lewe górne pole celu
+     */
+    void build(const std::vector<const Tile*>& rows, int columns_count, SDL_Point goal);
+    /**
+     * Rezerwacja pamięci dla mapy o podanych wymiarach, aby pierwsze wyznaczenie pola w trakcie rozgrywki nie przydzielało pamięci.
+     * @param rows_count - liczba wierszy mapy
+     * @param columns_count - liczba kolumn mapy
+     */
+    void reserve(int rows_count, int columns_count);
+    /**
+     * Poprawienie pola odległości po zmianie jednego pola mapy. Jeśli przeszkoda zniknęła, odległości są zmniejszane tylko tam, gdzie to potrzebne;
+     * jeśli przeszkoda przybyła, pole jest wyznaczane od nowa.
+     * @param rows - wiersze mapy
+     * @param columns_count - liczba kolumn mapy
+     * @param row - wiersz zmienionego pola
+     * @param column - kolumna zmienionego pola
+     */
+    void update(const std::vector<const Tile*>& rows, int columns_count, int row, int column);
+    /**
+     * Porzucenie pola; kolejne użycie wymaga @a FlowField::build.
+     */
+    void clear();
+    /**
+     * @return lewe górne pole celu lub (-1, -1) jeśli pole nie zostało wyznaczone
+     */
+    SDL_Point goal() const;
+    /**
+     * Kierunek jazdy prowadzący najkrótszą drogą do celu.
+     * @param x - położenie poziome czołgu w pikselach
+     * @param y - położenie pionowe czołgu w pikselach
+     * @param direction - kierunek jazdy
+     * @return false jeśli czołg jest już u celu albo nie ma drogi do celu
+     */
+    bool direction(double x, double y, Direction& direction) const;
+    /**
+     * @param x - położenie poziome czołgu w pikselach
+     * @param y - położenie pionowe czołgu w pikselach
+     * @return lewe górne pole najbliższe położeniu czołgu
+     */
+    static SDL_Point footprintAt(double x, double y);
+
+private:
+    /**
+     * Koszt wjazdu na położenie o podanym lewym górnym polu; 0 oznacza położenie nieprzejezdne.
+     */
+    static Uint8 footprintCost(const std::vector<const Tile*>& rows, int x, int y);
+    /**
+     * Koszt wjazdu na pole mapy: 1, @a FlowField::brick_cost lub wartość oznaczająca pole nieprzejezdne.
+     */
+    static Uint8 cellCost(const Tile& tile);
+    /**
+     * Rozprowadzenie zmniejszonych odległości od położeń z @a m_queue.
+     */
+    void propagate();
+
+    /**
+     * Liczba położeń w poziomie i w pionie.
+     */
+    int m_width;
+    int m_height;
+    SDL_Point m_goal;
+    /**
+     * Koszt wjazdu na każde położenie.
+     */
+    std::vector<Uint8> m_cost;
+    /**
+     * Koszt wjazdu na każde pole mapy; bufor używany przez @a FlowField::build.
+     */
+    std::vector<Uint8> m_cells;
+    /**
+     * Koszt dojazdu z każdego położenia do celu.
+     */
+    std::vector<Uint16> m_distance;
+    /**
+     * Kubełki odległości używane cyklicznie przez @a FlowField::build.
+     */
+    std::vector< std::vector<int> > m_buckets;
+    /**
+     * Kolejka położeń, których odległość zmalała.
+     */
+    std::vector<int> m_queue;
+    /**
+     * Znacznik położeń czekających w @a m_queue.
+     */
+    std::vector<Uint8> m_queued;
+};
+
+#endif // FLOWFIELD_H
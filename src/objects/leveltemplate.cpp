@@ -0,0 +1,111 @@
+#include "leveltemplate.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+/**
+ * Wzorce wczytanych poziomów indeksowane numerem poziomu.
+ */
+static std::vector< std::shared_ptr<const LevelTemplate> > s_templates;
+static SDL_SpinLock s_templates_lock = 0;
+
+/*
+. = puste pole
+# = murek
+@ = kamień
+% = krzaki
+~ = woda
+- = lód
+ */
+
+LevelTemplate::LevelTemplate(const LevelData& data)
+{
+    rows_count = data.rows_count;
+    columns_count = data.columns_count;
+    tiles.assign(rows_count * columns_count, Tile());
+
+    for(int j = 0; j < rows_count; j++)
+    {
+        const char* row = data.cells.data() + j * columns_count;
+        for(int i = 0; i < columns_count; i++)
+        {
+            Tile& tile = tiles.at(j * columns_count + i);
+            switch(row[i])
+            {
+            case '#' : tile = Tile(ST_BRICK_WALL); break;
+            case '@' : tile = Tile(ST_STONE_WALL); break;
+            case '~' : tile = Tile(ST_WATER); break;
+            case '-' : tile = Tile(ST_ICE); break;
+            case '%' : bushes.push_back({i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h}); break;
+            }
+        }
+    }
+
+    SDL_Point eagle_cell = data.eagle.x >= 0 ? data.eagle : SDL_Point{12, rows_count - 2};
+    eagle = {eagle_cell.x * AppConfig::tile_rect.w, eagle_cell.y * AppConfig::tile_rect.h};
+
+    //wyczyszczenie miejsca orzełeka
+    for(int i = eagle_cell.x; i < eagle_cell.x + 2 && i < columns_count; i++)
+    {
+        for(int j = std::max(eagle_cell.y, 0); j < eagle_cell.y + 2 && j < rows_count; j++)
+        {
+            tiles.at(j * columns_count + i) = Tile();
+        }
+    }
+    //mur łopaty zajmuje pola wokół orzełka mieszczące się na mapie
+    for(int j = eagle_cell.y - 1; j < eagle_cell.y + 3; j++)
+    {
+        for(int i = eagle_cell.x - 1; i < eagle_cell.x + 3; i++)
+        {
+            bool inside_eagle = i >= eagle_cell.x && i < eagle_cell.x + 2 && j >= eagle_cell.y && j < eagle_cell.y + 2;
+            if(!inside_eagle && i >= 0 && j >= 0 && i < columns_count && j < rows_count) eagle_wall.push_back({i, j});
+        }
+    }
+
+    //wrogowie pojawiają się z jednopikselowym marginesem, tak jak w AppConfig::enemy_starting_point
+    if(data.player_starts.empty()) player_starts = AppConfig::player_starting_point;
+    for(auto& cell : data.player_starts)
+        player_starts.push_back({cell.x * AppConfig::tile_rect.w, cell.y * AppConfig::tile_rect.h});
+    if(data.enemy_spawns.empty()) enemy_spawns = AppConfig::enemy_starting_point;
+    for(auto& cell : data.enemy_spawns)
+        enemy_spawns.push_back({cell.x * AppConfig::tile_rect.w + 1, cell.y * AppConfig::tile_rect.h + 1});
+
+    for(auto& enemy : data.roster)
+        roster.push_back({static_cast<SpriteType>(ST_TANK_A + enemy.type - 'A'), enemy.lives, enemy.bonus});
+}
+
+std::shared_ptr<const LevelTemplate> LevelTemplate::get(int level)
+{
+    std::shared_ptr<const LevelTemplate> level_template = cached(level);
+    if(level_template != nullptr) return level_template;
+
+    LevelLoader* loader = Engine::getEngine().getLevelLoader();
+    LevelData data;
+    if(!loader->take(level, data) && !loader->load(level, data))
+        data = LevelData(); //poziomu nie udało się wczytać - pusta mapa
+    level_template = std::make_shared<const LevelTemplate>(data);
+    store(level, level_template);
+    return level_template;
+}
+
+void LevelTemplate::store(int level, std::shared_ptr<const LevelTemplate> level_template)
+{
+    if(level < 0) return;
+    SDL_AtomicLock(&s_templates_lock);
+    if(static_cast<unsigned>(level) >= s_templates.size()) s_templates.resize(level + 1);
+    s_templates.at(level) = level_template;
+    SDL_AtomicUnlock(&s_templates_lock);
+}
+
+std::shared_ptr<const LevelTemplate> LevelTemplate::cached(int level)
+{
+    std::shared_ptr<const LevelTemplate> level_template;
+    SDL_AtomicLock(&s_templates_lock);
+    if(level >= 0 && static_cast<unsigned>(level) < s_templates.size()) level_template = s_templates.at(level);
+    SDL_AtomicUnlock(&s_templates_lock);
+    return level_template;
+}
+
+const Tile* LevelTemplate::row(int row) const
+{
+    return &tiles.at(row * columns_count);
+}
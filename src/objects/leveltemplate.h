@@ -0,0 +1,98 @@
+#ifndef LEVELTEMPLATE_H
+#define LEVELTEMPLATE_H
+
+#include "tile.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief
+ * Niezmienny, przetworzony opis poziomu współdzielony przez wszystkie rozgrywki na tej samej mapie.
+ * Rozgrywka korzysta bezpośrednio z pól wzorca i kopiuje do własnej pamięci tylko te wiersze mapy, które zmienia (zniszczone murki, mur wokół orzełka).
+ * Wzorce wczytanych poziomów są przechowywane w pamięci podręcznej, więc ponowne rozpoczęcie poziomu nie wymaga jego wczytywania.
+ * @see Game::editTile
+ */
+class LevelTemplate
+{
+public:
+    /**
+     * @brief Wróg z listy wrogów poziomu.
+     */
+    struct RosterEntry
+    {
+        SpriteType type;
+        int lives_count;
+        bool bonus;
+    };
+
+    /**
+     * Tworzenie wzorca z opisu poziomu; miejsce orzełka jest czyszczone z przeszkód.
+     * Metadane, których nie ma w opisie, przyjmują wartości domyślne: orzełek w kolumnie 12 dwóch ostatnich wierszy,
+     * położenia z @a AppConfig::player_starting_point i @a AppConfig::enemy_starting_point oraz brak listy wrogów.
+     * @param data - opis poziomu
+     */
+    LevelTemplate(const LevelData& data);
+
+    /**
+     * Wzorzec poziomu z pamięci podręcznej, a jeśli go tam nie ma - utworzony z poziomu odebranego z @a LevelLoader lub wczytanego od razu.
+     * @param level - numer poziomu
+     * @return wzorzec poziomu
+     */
+    static std::shared_ptr<const LevelTemplate> get(int level);
+    /**
+     * @param level - numer poziomu
+     * @return wzorzec poziomu z pamięci podręcznej lub nullptr, jeśli poziom nie był jeszcze wczytany
+     */
+    static std::shared_ptr<const LevelTemplate> cached(int level);
+    /**
+     * Zastąpienie wzorca w pamięci podręcznej, np. po zmianie pliku poziomu; rozgrywki korzystające z poprzedniego wzorca zachowują go.
+     * @param level - numer poziomu
+     * @param level_template - nowy wzorzec poziomu
+     */
+    static void store(int level, std::shared_ptr<const LevelTemplate> level_template);
+
+    /**
+     * @param row - wiersz z przedziału [0, rows_count)
+     * @return wskaźnik na pierwsze pole wiersza
+     */
+    const Tile* row(int row) const;
+
+    /**
+     * Liczba wierszy mapy.
+     */
+    int rows_count;
+    /**
+     * Liczba kolumn mapy.
+     */
+    int columns_count;
+    /**
+     * Pola mapy zapisane kolejnymi wierszami.
+     */
+    std::vector<Tile> tiles;
+    /**
+     * Położenia krzaków na mapie.
+     */
+    std::vector<SDL_Point> bushes;
+    /**
+     * Położenie orzełka na mapie.
+     */
+    SDL_Point eagle;
+    /**
+     * Pola mapy wokół orzełka (kolumna, wiersz), na których łopata buduje kamienny mur.
+     */
+    std::vector<SDL_Point> eagle_wall;
+    /**
+     * Położenia startowe kolejnych graczy.
+     */
+    std::vector<SDL_Point> player_starts;
+    /**
+     * Położenia, w których na zmianę pojawiają się wrogowie.
+     */
+    std::vector<SDL_Point> enemy_spawns;
+    /**
+     * Wrogowie poziomu w kolejności pojawiania się; jeśli lista jest pusta, typ i pancerz wroga są losowane.
+     */
+    std::vector<RosterEntry> roster;
+};
+
+#endif // LEVELTEMPLATE_H
@@ -0,0 +1,129 @@
+#include "lineofsight.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+/**
+ * Dzielenie zaokrąglane w dół również dla liczb ujemnych.
+ */
+static int floorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+LineOfSight::LineOfSight()
+{
+    m_columns_count = 0;
+    m_rows_count = 0;
+}
+
+void LineOfSight::build(const std::vector<const Tile*>& rows, int columns_count)
+{
+    m_columns_count = columns_count;
+    m_rows_count = rows.size();
+    m_types.resize(m_rows_count * m_columns_count);
+    m_left.resize(m_types.size());
+    m_right.resize(m_types.size());
+    m_up.resize(m_types.size());
+    m_down.resize(m_types.size());
+
+    for(int j = 0; j < m_rows_count; j++)
+        for(int i = 0; i < m_columns_count; i++)
+            m_types[j * m_columns_count + i] = blockingType(rows[j][i]);
+    for(int j = 0; j < m_rows_count; j++) updateRow(j);
+    for(int i = 0; i < m_columns_count; i++) updateColumn(i);
+}
+
+void LineOfSight::update(const std::vector<const Tile*>& rows, int row, int column)
+{
+    Uint8 type = blockingType(rows[row][column]);
+    Uint8& current = m_types[row * m_columns_count + column];
+    if(type == current) return;
+    current = type;
+    updateRow(row);
+    updateColumn(column);
+}
+
+Uint8 LineOfSight::cast(const SDL_Rect& rect, int width, Direction direction, int& distance) const
+{
+    bool vertical = direction == D_UP || direction == D_DOWN;
+    bool backward = direction == D_UP || direction == D_LEFT;
+    int lane_size = vertical ? AppConfig::tile_rect.w : AppConfig::tile_rect.h;
+    int step_size = vertical ? AppConfig::tile_rect.h : AppConfig::tile_rect.w;
+    int lanes_count = vertical ? m_columns_count : m_rows_count;
+    int length = vertical ? m_rows_count : m_columns_count;
+
+    //wiersze lub kolumny, przez które przelatuje pocisk
+    int center = vertical ? rect.x + rect.w / 2 : rect.y + rect.h / 2;
+    int first_lane = std::max(floorDiv(center - width / 2, lane_size), 0);
+    int last_lane = std::min(floorDiv(center + (width + 1) / 2 - 1, lane_size), lanes_count - 1);
+    //przedni bok czołgu i pierwsze pole przed nim
+    int front = vertical ? (backward ? rect.y : rect.y + rect.h) : (backward ? rect.x : rect.x + rect.w);
+    int start = backward ? floorDiv(front - 1, step_size) : floorDiv(front, step_size);
+
+    Uint8 type = ST_NONE;
+    int block = backward ? -1 : length;
+    for(int lane = first_lane; lane <= last_lane && start >= 0 && start < length; lane++)
+    {
+        int found;
+        switch(direction)
+        {
+        case D_UP: found = m_up[lane * m_rows_count + start]; break;
+        case D_DOWN: found = m_down[lane * m_rows_count + start]; break;
+        case D_LEFT: found = m_left[lane * m_columns_count + start]; break;
+        default: found = m_right[lane * m_columns_count + start]; break;
+        }
+        if(found < 0 || found >= length) continue;
+
+        Uint8 found_type = vertical ? m_types[found * m_columns_count + lane] : m_types[lane * m_columns_count + found];
+        bool nearer = backward ? found > block : found < block;
+        if(nearer || (found == block && found_type == ST_BRICK_WALL))
+        {
+            block = found;
+            type = found_type;
+        }
+    }
+    distance = backward ? front - (block + 1) * step_size : block * step_size - front;
+    return type;
+}
+
+Uint8 LineOfSight::blockingType(const Tile& tile)
+{
+    return tile.type == ST_BRICK_WALL || tile.type == ST_STONE_WALL ? tile.type : static_cast<Uint8>(ST_NONE);
+}
+
+void LineOfSight::updateRow(int row)
+{
+    const Uint8* types = &m_types[row * m_columns_count];
+    Sint16* left = &m_left[row * m_columns_count];
+    Sint16* right = &m_right[row * m_columns_count];
+    Sint16 last = -1;
+    for(int i = 0; i < m_columns_count; i++)
+    {
+        if(types[i] != ST_NONE) last = i;
+        left[i] = last;
+    }
+    last = m_columns_count;
+    for(int i = m_columns_count - 1; i >= 0; i--)
+    {
+        if(types[i] != ST_NONE) last = i;
+        right[i] = last;
+    }
+}
+
+void LineOfSight::updateColumn(int column)
+{
+    Sint16* up = &m_up[column * m_rows_count];
+    Sint16* down = &m_down[column * m_rows_count];
+    Sint16 last = -1;
+    for(int j = 0; j < m_rows_count; j++)
+    {
+        if(m_types[j * m_columns_count + column] != ST_NONE) last = j;
+        up[j] = last;
+    }
+    last = m_rows_count;
+    for(int j = m_rows_count - 1; j >= 0; j--)
+    {
+        if(m_types[j * m_columns_count + column] != ST_NONE) last = j;
+        down[j] = last;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef LINEOFSIGHT_H
+#define LINEOFSIGHT_H
+
+#include "tile.h"
+#include <vector>
+
+/**
+ * @brief
+ * Tablice przeszkód zatrzymujących pociski (murków i kamieni) wzdłuż wierszy i kolumn mapy, pozwalające w stałym czasie znaleźć pierwszą przeszkodę na linii strzału.
+ * Dla każdego pola zapisane jest najbliższe pole z przeszkodą w każdym z czterech kierunków. Po zniszczeniu murku przeliczany jest tylko jego wiersz i kolumna.
+ */
+class LineOfSight
+{
+public:
+    LineOfSight();
+
+    /**
+     * Wyznaczenie tablic dla całej mapy.
+     * @param rows - wiersze mapy
+     * @param columns_count - liczba kolumn mapy
+     */
+    void build(const std::vector<const Tile*>& rows, int columns_count);
+    /**
+     * Przeliczenie wiersza i kolumny zmienionego pola mapy.
+     * @param rows - wiersze mapy
+     * @param row - wiersz pola
+     * @param column - kolumna pola
+     */
+    void update(const std::vector<const Tile*>& rows, int row, int column);
+    /**
+     * Pierwsza przeszkoda na drodze pocisku wystrzelonego z czołgu.
+     * @param rect - prostokąt czołgu; pocisk wylatuje ze środka jego boku
+     * @param width - szerokość pocisku
+     * @param direction - kierunek strzału
+     * @param distance - odległość w pikselach od boku czołgu do przeszkody lub, gdy przeszkody nie ma, do granicy mapy
+     * @return rodzaj przeszkody: @a ST_BRICK_WALL, @a ST_STONE_WALL lub @a ST_NONE, jeśli pocisk doleci do granicy mapy; jeśli pocisk trafi jednocześnie w murek i kamień, zwracany jest murek
+     */
+    Uint8 cast(const SDL_Rect& rect, int width, Direction direction, int& distance) const;
+
+private:
+    /**
+     * @return rodzaj pola, jeśli zatrzymuje pociski, lub @a ST_NONE
+     */
+    static Uint8 blockingType(const Tile& tile);
+    /**
+     * Przeliczenie tablic @a m_left i @a m_right dla wiersza.
+     */
+    void updateRow(int row);
+    /**
+     * Przeliczenie tablic @a m_up i @a m_down dla kolumny.
+     */
+    void updateColumn(int column);
+
+    int m_columns_count;
+    int m_rows_count;
+    /**
+     * Rodzaj przeszkody na każdym polu mapy (zapisane wierszami).
+     */
+    std::vector<Uint8> m_types;
+    /**
+     * Kolumna najbliższej przeszkody na lewo od pola i na nim lub -1 (zapisane wierszami).
+     */
+    std::vector<Sint16> m_left;
+    /**
+     * Kolumna najbliższej przeszkody na prawo od pola i na nim lub liczba kolumn (zapisane wierszami).
+     */
+    std::vector<Sint16> m_right;
+    /**
+     * Wiersz najbliższej przeszkody nad polem i na nim lub -1 (zapisane kolumnami).
+     */
+    std::vector<Sint16> m_up;
+    /**
+     * Wiersz najbliższej przeszkody pod polem i na nim lub liczba wierszy (zapisane kolumnami).
+     */
+    std::vector<Sint16> m_down;
+};
+
+#endif // LINEOFSIGHT_H
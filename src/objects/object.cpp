@@ -120,7 +120,7 @@ SDL_Rect Object::moveRect(const SDL_Rect &rect, int x, int y)
 }
 
 
-SDL_Rect intersectRect(SDL_Rect *rect1, SDL_Rect *rect2)
+SDL_Rect intersectRect(const SDL_Rect *rect1, const SDL_Rect *rect2)
 {
     SDL_Rect intersect_rect;
     intersect_rect.x = std::max(rect1->x, rect2->x);
@@ -99,6 +99,6 @@ protected:
  * @param rect2
  * @return część wspólną, jeśli rect1 i rect2 nie mają części wspólnej prostokąt wyjściowy będzie miał ujemne wymiary
  */
-SDL_Rect intersectRect(SDL_Rect* rect1, SDL_Rect* rect2);
+SDL_Rect intersectRect(const SDL_Rect* rect1, const SDL_Rect* rect2);
 
 #endif // OBJECT_H
@@ -3,29 +3,27 @@
 #include <SDL2/SDL.h>
 #include <iostream>
 
-Player::Player()
-    : Tank(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1)
+Player::Player(TankStore* store)
+    : Tank(store, AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1)
 {
-    speed = 0;
+    starting_point = AppConfig::player_starting_point.at(0);
     lives_count = 11;
     m_bullet_max_size = AppConfig::player_bullet_max_size;
+    bullets.reserve(m_bullet_max_size);
     score = 0;
     star_count = 0;
-    m_shield = new Object(0, 0, ST_SHIELD);
-    m_shield_time = 0;
     respawn();
 }
 
-Player::Player(double x, double y, SpriteType type)
-    : Tank(x, y, type)
+Player::Player(TankStore* store, double x, double y, SpriteType type)
+    : Tank(store, x, y, type)
 {
-   speed = 0;
+   starting_point = {static_cast<int>(x), static_cast<int>(y)};
    lives_count = 11;
    m_bullet_max_size = AppConfig::player_bullet_max_size;
+   bullets.reserve(m_bullet_max_size);
    score = 0;
    star_count = 0;
-   m_shield = new Object(x, y, ST_SHIELD);
-   m_shield_time = 0;
    respawn();
 }
 
@@ -40,27 +38,27 @@ void Player::update(Uint32 dt)
         if(key_state[player_keys.up])
         {
             setDirection(D_UP);
-            speed = default_speed;
+            setSpeed(default_speed);
         }
         else if(key_state[player_keys.down])
         {
             setDirection(D_DOWN);
-            speed = default_speed;
+            setSpeed(default_speed);
         }
         else if(key_state[player_keys.left])
         {
             setDirection(D_LEFT);
-            speed = default_speed;
+            setSpeed(default_speed);
         }
         else if(key_state[player_keys.right])
         {
             setDirection(D_RIGHT);
-            speed = default_speed;
+            setSpeed(default_speed);
         }
         else
         {
-            if(!testFlag(TSF_ON_ICE) || m_slip_time == 0)
-                speed = 0.0;
+            if(!testFlag(TSF_ON_ICE) || m_store->slipTime(storeIndex()) == 0)
+                setSpeed(0.0);
         }
 
         if(key_state[player_keys.fire] && m_fire_time > AppConfig::player_reload_time)
@@ -72,12 +70,15 @@ void Player::update(Uint32 dt)
 
     m_fire_time += dt;
 
+    int index = storeIndex();
+    const SpriteData* sprite = m_store->sprite(index);
+    int frame = m_store->frame(index);
     if(testFlag(TSF_LIFE))
-        src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction), m_current_frame + 2 * star_count);
+        src_rect = moveRect(sprite->rect, facing(), frame + 2 * star_count);
     else
-        src_rect = moveRect(m_sprite->rect, 0, m_current_frame + 2 * star_count);
+        src_rect = moveRect(sprite->rect, 0, frame + 2 * star_count);
 
-    stop = false;
+    setStopped(false);
 }
 
 void Player::respawn()
@@ -89,26 +90,18 @@ void Player::respawn()
         return;
     }
 
-    if(type == ST_PLAYER_1)
-    {
-        pos_x = AppConfig::player_starting_point.at(0).x;
-        pos_y = AppConfig::player_starting_point.at(0).y;
-    }
-    else
-    {
-        pos_x = AppConfig::player_starting_point.at(1).x;
-        pos_y = AppConfig::player_starting_point.at(1).y;
-    }
+    setPosition(starting_point.x, starting_point.y);
 
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
-    dest_rect.h = m_sprite->rect.h;
-    dest_rect.w = m_sprite->rect.w;
+    const SpriteData* sprite = m_store->sprite(storeIndex());
+    dest_rect.x = starting_point.x;
+    dest_rect.y = starting_point.y;
+    dest_rect.h = sprite->rect.h;
+    dest_rect.w = sprite->rect.w;
 
     setDirection(D_UP);
     Tank::respawn();
     setFlag(TSF_SHIELD);
-    m_shield_time = AppConfig::tank_shield_time / 2;
+    m_store->setShieldTime(storeIndex(), AppConfig::tank_shield_time / 2);
 }
 
 void Player::destroy()
@@ -129,13 +122,14 @@ void Player::destroy()
     }
 }
 
-Bullet* Player::fire()
+BulletStore::Handle Player::fire()
 {
-    Bullet* b = Tank::fire();
-    if(b != nullptr)
+    BulletStore::Handle b = Tank::fire();
+    int bullet = bullet_store != nullptr ? bullet_store->indexOf(b) : -1;
+    if(bullet >= 0)
     {
-        if(star_count > 0) b->speed = AppConfig::bullet_default_speed * 1.3;
-        if(star_count == 3) b->increased_damage = true;
+        if(star_count > 0) bullet_store->setSpeed(bullet, AppConfig::bullet_default_speed * 1.3);
+        if(star_count == 3) bullet_store->setFlag(bullet, BulletStore::BF_INCREASED_DAMAGE);
     }
     return b;
 }
@@ -148,6 +142,7 @@ void Player::changeStarCountBy(int c)
 
     if(star_count >= 2 && c > 0) m_bullet_max_size++;
     else m_bullet_max_size = 2;
+    bullets.reserve(m_bullet_max_size);
 
     if(star_count > 0) default_speed = AppConfig::tank_default_speed * 1.3;
     else default_speed = AppConfig::tank_default_speed;
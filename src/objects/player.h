@@ -41,16 +41,18 @@ public:
 
     /**
      * Tworzenie gracza w pierwszym z położeń graczy.
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @see AppConfig::player_starting_point
      */
-    Player();
+    Player(TankStore* store);
     /**
-     * Tworzenie czołgu gracza
+     * Tworzenie czołgu gracza w podanym położeniu startowym.
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @param x - pozycja początkowa pozioma
      * @param y - pozycja początkowa pionowa
      * @param type - typ gracza
      */
-    Player(double x, double y, SpriteType type);
+    Player(TankStore* store, double x, double y, SpriteType type);
 
 
     /**
@@ -69,9 +71,9 @@ public:
     /**
      * Funkcja odpowiada za stworzenie pocisku jeżeli jeszcze nie stworzono maksymalnej ich ilości,
      * nadaniu mu większej szybkości jeżeli gracz ma przynajmniej jedną gwiazdkę oraz dodaniu zwiększonych obrażeni jeżeli gracz ma trzy gwiazdki.
-     * @return wskaźnik na utworzony pocisk, jeżeli nie stworzono pocisku zwraca @a nullptr
+     * @return uchwyt utworzonego pocisku, jeżeli nie stworzono pocisku zwraca @a BulletStore::null_handle
      */
-    Bullet* fire();
+    BulletStore::Handle fire();
 
     /**
      * Funkcja zmienia liczbę aktualnie posiadanych gwiazdek. Przy niezerowej liczbie gwiazdek zwiększana jest domyślna prędkość czołgu,
@@ -84,6 +86,10 @@ public:
      * Klawiszcze sterujące ruchami aktualngo gracza.
      */
     PlayerKeys player_keys;
+    /**
+     * Położenie, w którym gracz pojawia się po utracie życia; ustawiane przez grę zgodnie z bieżącym poziomem.
+     */
+    SDL_Point starting_point;
     /**
      * Aktualnie posiadane punkty przez gracza.
      */
@@ -1,48 +1,31 @@
 #include "tank.h"
 #include "../appconfig.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
-Tank::Tank()
+Tank::Tank(TankStore* store)
     : Object(AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A)
 {
-    direction = D_UP;
-    m_slip_time = 0;
+    m_store = store;
+    m_handle = m_store->insert(AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A);
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
-    m_shield = nullptr;
-    m_boat = nullptr;
-    m_shield_time = 0;
-    m_frozen_time = 0;
+    bullet_store = nullptr;
 }
 
-Tank::Tank(double x, double y, SpriteType type)
+Tank::Tank(TankStore* store, double x, double y, SpriteType type)
     : Object(x, y, type)
 {
-    direction = D_UP;
-    m_slip_time = 0;
+    m_store = store;
+    m_handle = m_store->insert(x, y, type);
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
-    m_shield = nullptr;
-    m_boat = nullptr;
-    m_shield_time = 0;
-    m_frozen_time = 0;
+    bullet_store = nullptr;
 }
 
 Tank::~Tank()
 {
-    for(auto bullet : bullets) delete bullet;
-    bullets.clear();
-
-    if(m_shield != nullptr)
-    {
-        delete m_shield;
-        m_shield = nullptr;
-    }
-    if(m_boat != nullptr)
-    {
-        delete m_boat;
-        m_boat = nullptr;
-    }
+    releaseBullets();
+    m_store->erase(m_handle);
 }
 
 void Tank::draw()
@@ -50,41 +33,23 @@ void Tank::draw()
     if(to_erase) return;
     Object::draw();
 
-    if(testFlag(TSF_SHIELD) && m_shield != nullptr) m_shield->draw();
-    if(testFlag(TSF_BOAT) && m_boat != nullptr) m_boat->draw();
-
-    for(auto bullet : bullets)
-        if(bullet != nullptr) bullet->draw();
+    if(testFlag(TSF_SHIELD)) m_shield.draw();
+    if(testFlag(TSF_BOAT)) m_boat.draw();
 }
 
 void Tank::update(Uint32 dt)
 {
     if(to_erase) return;
-    if(testFlag(TSF_LIFE))
+    int index = storeIndex();
+    TankStateFlags flags = m_store->flags(index);
+    Uint8 events = m_store->events(index);
+    if(events & TankStore::TE_LIFE)
     {
-        if(!stop && !testFlag(TSF_FROZEN))
-        {
-            switch (direction)
-            {
-            case D_UP:
-                pos_y -= speed * dt;
-                break;
-            case D_RIGHT:
-                pos_x += speed * dt;
-                break;
-            case D_DOWN:
-                pos_y += speed * dt;
-                break;
-            case D_LEFT:
-                pos_x -= speed * dt;
-                break;
-            }
-        }
-
-        dest_rect.x = pos_x;
-        dest_rect.y = pos_y;
-        dest_rect.h = m_sprite->rect.h;
-        dest_rect.w = m_sprite->rect.w;
+        const SpriteData* sprite = m_store->sprite(index);
+        dest_rect.x = m_store->x(index);
+        dest_rect.y = m_store->y(index);
+        dest_rect.h = sprite->rect.h;
+        dest_rect.w = sprite->rect.w;
 
         collision_rect.x = dest_rect.x + 2;
         collision_rect.y = dest_rect.y + 2;
@@ -92,161 +57,188 @@ void Tank::update(Uint32 dt)
         collision_rect.w = dest_rect.w - 4;
     }
 
-    if(testFlag(TSF_ON_ICE) && m_slip_time > 0)
-    {
-        m_slip_time -= dt;
-        if(m_slip_time <= 0)
-        {
-            clearFlag(TSF_ON_ICE);
-            m_slip_time = 0;
-            direction = new_direction;
-        }
-    }
-
-    if(testFlag(TSF_SHIELD) && m_shield != nullptr)
+    if(flags & TSF_SHIELD)
     {
-        m_shield_time += dt;
-        m_shield->pos_x = pos_x;
-        m_shield->pos_y = pos_y;
-        m_shield->update(dt);
-        if(m_shield_time > AppConfig::tank_shield_time) clearFlag(TSF_SHIELD);
+        m_shield.pos_x = m_store->x(index);
+        m_shield.pos_y = m_store->y(index);
+        m_shield.update(dt);
     }
-    if(testFlag(TSF_BOAT) && m_boat != nullptr)
+    if(flags & TSF_BOAT)
     {
-        m_boat->pos_x = pos_x;
-        m_boat->pos_y = pos_y;
-        m_boat->update(dt);
+        m_boat.pos_x = m_store->x(index);
+        m_boat.pos_y = m_store->y(index);
+        m_boat.update(dt);
     }
-    if(testFlag(TSF_FROZEN))
+
+    if(events & TankStore::TE_DESTROY_FINISHED)
     {
-        m_frozen_time += dt;
-        if(m_frozen_time > AppConfig::tank_frozen_time) clearFlag(TSF_FROZEN);
+        if(lives_count > 0) respawn();
+        else if(bullets.size() == 0) to_erase = true;
     }
 
-    if(m_sprite->frames_count > 1 && (testFlag(TSF_LIFE) ? speed > 0 : true)) //brak animacji jeśli czołg nie prógbuje jechać
+    //pociski porusza magazyn; czołg zapomina tylko pociski, których wybuch się skończył
+    //usunięty uchwyt zastępuje ostatni z kontenera, który jeszcze nie był sprawdzany
+    for(unsigned i = 0; i < bullets.size();)
     {
-        m_frame_display_time += dt;
-        if(m_frame_display_time > (testFlag(TSF_MENU)  ? m_sprite->frame_duration / 2 : m_sprite->frame_duration))
+        int bullet = bullet_store->indexOf(bullets.at(i));
+        if(bullet < 0 || bullet_store->testFlag(bullet, BulletStore::BF_FINISHED))
         {
-            m_frame_display_time = 0;
-            m_current_frame++;
-            if(m_current_frame >= m_sprite->frames_count)
-            {
-                if(m_sprite->loop) m_current_frame = 0;
-                else if(testFlag(TSF_CREATE))
-                {
-                    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(type);
-                    clearFlag(TSF_CREATE);
-                    setFlag(TSF_LIFE);
-                    m_current_frame = 0;
-                }
-                else if(testFlag(TSF_DESTROYED))
-                {
-                    m_current_frame = m_sprite->frames_count;
-                    if(lives_count > 0) respawn();
-                    else if(bullets.size() == 0) to_erase = true;
-                }
-            }
+            bullets.at(i) = bullets.back();
+            bullets.pop_back();
         }
+        else i++;
     }
-
-
-    // Obsługa pocisku
-    for(auto bullet : bullets) bullet->update(dt);
-    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](Bullet*b){if(b->to_erase) {delete b; return true;} return false;}), bullets.end());
 }
 
-Bullet* Tank::fire()
+BulletStore::Handle Tank::fire()
 {
-    if(!testFlag(TSF_LIFE)) return nullptr;
+    if(!testFlag(TSF_LIFE) || bullet_store == nullptr) return BulletStore::null_handle;
     if(bullets.size() < m_bullet_max_size)
     {
-        //podajemy początkową dowolną pozycję, bo nie znamy wymiarów pocisku
-        Bullet* bullet = new Bullet(pos_x, pos_y);
-        bullets.push_back(bullet);
+        double x = posX(), y = posY();
+        int w = bullet_store->width(), h = bullet_store->height();
 
-        Direction tmp_d = (testFlag(TSF_ON_ICE) ? new_direction : direction);
+        Direction tmp_d = facing();
         switch(tmp_d)
         {
         case D_UP:
-            bullet->pos_x += (dest_rect.w - bullet->dest_rect.w) / 2;
-            bullet->pos_y -= bullet->dest_rect.h - 4;
+            x += (dest_rect.w - w) / 2;
+            y -= h - 4;
             break;
         case D_RIGHT:
-            bullet->pos_x += dest_rect.w - 4;
-            bullet->pos_y += (dest_rect.h - bullet->dest_rect.h) / 2;
+            x += dest_rect.w - 4;
+            y += (dest_rect.h - h) / 2;
             break;
         case D_DOWN:
-            bullet->pos_x += (dest_rect.w - bullet->dest_rect.w) / 2;
-            bullet->pos_y += dest_rect.h - 4;
+            x += (dest_rect.w - w) / 2;
+            y += dest_rect.h - 4;
             break;
         case D_LEFT:
-            bullet->pos_x -= bullet->dest_rect.w - 4;
-            bullet->pos_y += (dest_rect.h - bullet->dest_rect.h) / 2;
+            x -= w - 4;
+            y += (dest_rect.h - h) / 2;
             break;
         }
 
-        bullet->direction = tmp_d;
-        if(type == ST_TANK_C)
-            bullet->speed = AppConfig::bullet_default_speed * 1.3;
-        else
-            bullet->speed = AppConfig::bullet_default_speed;
+        double bullet_speed = AppConfig::bullet_default_speed;
+        if(type == ST_TANK_C) bullet_speed *= 1.3;
 
-        bullet->update(0); //zmiana pozycji dest_rect
+        BulletStore::Handle bullet = bullet_store->insert(x, y, tmp_d, bullet_speed);
+        if(bullet != BulletStore::null_handle) bullets.push_back(bullet);
         return bullet;
     }
-    return nullptr;
+    return BulletStore::null_handle;
 }
 
-SDL_Rect Tank::nextCollisionRect(Uint32 dt)
+void Tank::attach(TankStore* store)
 {
+    if(store == m_store) return;
+    TankStore::Handle handle = store->insert(*m_store, storeIndex());
+    m_store->erase(m_handle);
+    m_store = store;
+    m_handle = handle;
+}
+
+void Tank::releaseBullets()
+{
+    if(bullet_store != nullptr)
+        for(auto bullet : bullets) bullet_store->erase(bullet);
+    bullets.clear();
+    bullet_store = nullptr;
+}
+
+SDL_Rect Tank::nextCollisionRect(Uint32 dt) const
+{
+    int index = storeIndex();
+    double speed = m_store->speed(index);
     if(speed == 0) return collision_rect;
 
-    SDL_Rect r;
-    int a = 1;
-    switch (direction)
+    SDL_Rect r = collision_rect;
+    int distance = speed * dt;
+    switch (m_store->direction(index))
     {
     case D_UP:
-        r.x = collision_rect.x;
-        r.y = collision_rect.y - default_speed * dt - a;
+        r.y -= distance;
         break;
     case D_RIGHT:
-        r.x = collision_rect.x + default_speed * dt + a;
-        r.y = collision_rect.y;
+        r.x += distance;
         break;
     case D_DOWN:
-        r.x = collision_rect.x;
-        r.y = collision_rect.y + default_speed * dt + a;
+        r.y += distance;
         break;
     case D_LEFT:
-        r.x = collision_rect.x - default_speed * dt - a;
-        r.y = collision_rect.y;
+        r.x -= distance;
         break;
     }
-    r.h = collision_rect.h;
-    r.w = collision_rect.w;
 
     return r;
 }
 
+double Tank::distanceTo(const SDL_Rect &rect) const
+{
+    return distanceTo(rect, motion());
+}
+
+double Tank::distanceTo(const SDL_Rect &rect, const Motion& motion) const
+{
+    const double no_limit = std::numeric_limits<double>::infinity();
+    if(rect.w <= 0 || rect.h <= 0 || collision_rect.w <= 0 || collision_rect.h <= 0) return no_limit;
+
+    //prostokąt kolizji czołgu jest przesunięty o 2 piksele względem pozycji; odległość liczymy od dokładnej pozycji
+    double pos_x = motion.x, pos_y = motion.y;
+    Direction direction = motion.direction;
+    double distance = 0;
+    switch (direction)
+    {
+    case D_UP:
+        if(rect.x >= collision_rect.x + collision_rect.w || rect.x + rect.w <= collision_rect.x || rect.y > collision_rect.y) return no_limit;
+        distance = pos_y + 2 - (rect.y + rect.h);
+        break;
+    case D_RIGHT:
+        if(rect.y >= collision_rect.y + collision_rect.h || rect.y + rect.h <= collision_rect.y || rect.x + rect.w < collision_rect.x + collision_rect.w) return no_limit;
+        distance = rect.x - (pos_x + 2 + collision_rect.w);
+        break;
+    case D_DOWN:
+        if(rect.x >= collision_rect.x + collision_rect.w || rect.x + rect.w <= collision_rect.x || rect.y + rect.h < collision_rect.y + collision_rect.h) return no_limit;
+        distance = rect.y - (pos_y + 2 + collision_rect.h);
+        break;
+    case D_LEFT:
+        if(rect.y >= collision_rect.y + collision_rect.h || rect.y + rect.h <= collision_rect.y || rect.x > collision_rect.x) return no_limit;
+        distance = pos_x + 2 - (rect.x + rect.w);
+        break;
+    }
+
+    if(distance < 0)
+    {
+        //przeszkoda już nachodzi na czołg; blokuje tylko wtedy, gdy styka się z nim od przodu
+        SDL_Rect intersect_rect = intersectRect(&rect, &collision_rect);
+        bool vertical = (direction == D_UP || direction == D_DOWN);
+        if(vertical != (intersect_rect.w > intersect_rect.h)) return no_limit;
+        distance = 0;
+    }
+    return distance;
+}
+
 void Tank::setDirection(Direction d)
 {
     if(!(testFlag(TSF_LIFE) || testFlag(TSF_CREATE))) return;
+    int index = storeIndex();
     if(testFlag(TSF_ON_ICE))
     {
-        new_direction = d;
-        if(speed == 0.0 || m_slip_time == 0.0) direction = d;
-        if((m_slip_time != 0 && direction == new_direction) || m_slip_time == 0)
-            m_slip_time = AppConfig::slip_time;
+        Sint32 slip_time = m_store->slipTime(index);
+        m_store->setNewDirection(index, d);
+        if(m_store->speed(index) == 0.0 || slip_time == 0.0) m_store->setDirection(index, d);
+        if((slip_time != 0 && m_store->direction(index) == d) || slip_time == 0)
+            m_store->setSlipTime(index, AppConfig::slip_time);
     }
     else
-        direction = d;
+        m_store->setDirection(index, d);
 
-    if(!stop)
+    if(!m_store->stopped(index))
     {
         double epsilon = 5;
+        double pos_x = m_store->x(index), pos_y = m_store->y(index);
         int pos_x_tile, pos_y_tile;
-        switch (direction)
+        switch (m_store->direction(index))
         {
         case D_UP:
         case D_DOWN:
@@ -261,28 +253,19 @@ void Tank::setDirection(Direction d)
             else if(pos_y_tile + AppConfig::tile_rect.h - pos_y < epsilon) pos_y = pos_y_tile + AppConfig::tile_rect.h;
             break;
         }
+        m_store->setPosition(index, pos_x, pos_y);
     }
 }
 
-void Tank::collide(SDL_Rect &intersect_rect)
+void Tank::collide(double distance)
 {
-    if(intersect_rect.w > intersect_rect.h) // kolizja od góry lub dołu
+    int index = storeIndex();
+    if(distance < m_store->maxMove(index)) m_store->setMaxMove(index, distance);
+    if(m_store->maxMove(index) <= 0)
     {
-        if((direction == D_UP && intersect_rect.y <= collision_rect.y) ||
-                (direction == D_DOWN && (intersect_rect.y + intersect_rect.h) >= (collision_rect.y + collision_rect.h)))
-        {
-            stop = true;
-            m_slip_time = 0;
-        }
-    }
-    else
-    {
-        if((direction == D_LEFT && intersect_rect.x <= collision_rect.x) ||
-                (direction == D_RIGHT && (intersect_rect.x + intersect_rect.w) >= (collision_rect.x + collision_rect.w)))
-        {
-            stop = true;
-            m_slip_time = 0;
-        }
+        m_store->setMaxMove(index, 0);
+        m_store->setStopped(index, true);
+        m_store->setSlipTime(index, 0);
     }
 }
 
@@ -290,85 +273,145 @@ void Tank::destroy()
 {
     if(!testFlag(TSF_LIFE)) return;
 
-    stop = true;
-    m_flags = TSF_DESTROYED;
+    int index = storeIndex();
+    m_store->setStopped(index, true);
+    m_store->setFlags(index, TSF_DESTROYED);
 
-    m_frame_display_time = 0;
-    m_current_frame = 0;
-    direction = D_UP;
-    speed = 0;
-    m_slip_time = 0;
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_TANK);
+    m_store->restartAnimation(index);
+    m_store->setDirection(index, D_UP);
+    m_store->setSpeed(index, 0);
+    m_store->setSlipTime(index, 0);
+    const SpriteData* sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_TANK);
+    m_store->setSprite(index, sprite);
 
     collision_rect.x = 0;
     collision_rect.y = 0;
     collision_rect.h = 0;
     collision_rect.w = 0;
 
-    dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w)/2;
-    dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h)/2;
-    dest_rect.h = m_sprite->rect.h;
-    dest_rect.w = m_sprite->rect.w;
+    dest_rect.x = m_store->x(index) + (dest_rect.w - sprite->rect.w)/2;
+    dest_rect.y = m_store->y(index) + (dest_rect.h - sprite->rect.h)/2;
+    dest_rect.h = sprite->rect.h;
+    dest_rect.w = sprite->rect.w;
 }
 
 void Tank::setFlag(TankStateFlag flag)
 {
+    int index = storeIndex();
     if(!testFlag(flag) && flag == TSF_ON_ICE)
-        new_direction = direction;
+        m_store->setNewDirection(index, m_store->direction(index));
 
     if(flag == TSF_SHIELD)
     {
-        if(m_shield == nullptr) m_shield = new Object(pos_x, pos_y, ST_SHIELD);
-         m_shield_time = 0;
+        if(!testFlag(TSF_SHIELD)) m_shield = Object(m_store->x(index), m_store->y(index), ST_SHIELD);
+         m_store->setShieldTime(index, 0);
     }
     if(flag == TSF_BOAT)
     {
-         if(m_boat == nullptr) m_boat = new Object(pos_x, pos_y, type == ST_PLAYER_1 ? ST_BOAT_P1 : ST_BOAT_P2);
+         if(!testFlag(TSF_BOAT)) m_boat = Object(m_store->x(index), m_store->y(index), type == ST_PLAYER_1 ? ST_BOAT_P1 : ST_BOAT_P2);
     }
     if(flag == TSF_FROZEN)
     {
-        m_frozen_time = 0;
+        m_store->setFrozenTime(index, 0);
     }
-    m_flags |= flag;
+    m_store->setFlags(index, m_store->flags(index) | flag);
 }
 
 void Tank::clearFlag(TankStateFlag flag)
 {
+    int index = storeIndex();
     if(flag == TSF_SHIELD)
     {
-         if(m_shield != nullptr) delete m_shield;
-         m_shield = nullptr;
-         m_shield_time = 0;
-    }
-    if(flag == TSF_BOAT)
-    {
-         if(m_boat != nullptr) delete m_boat;
-         m_boat = nullptr;
+         m_store->setShieldTime(index, 0);
     }
     if(flag == TSF_FROZEN)
     {
-        m_frozen_time = 0;
+        m_store->setFrozenTime(index, 0);
     }
-    m_flags &= ~flag;
+    m_store->setFlags(index, m_store->flags(index) & ~flag);
+}
+
+bool Tank::testFlag(TankStateFlag flag) const
+{
+    return (m_store->flags(storeIndex()) & flag) == flag;
+}
+
+unsigned Tank::bulletCapacity() const
+{
+    return m_bullet_max_size;
+}
+
+double Tank::posX() const
+{
+    return m_store->x(storeIndex());
+}
+
+double Tank::posY() const
+{
+    return m_store->y(storeIndex());
+}
+
+void Tank::setPosition(double x, double y)
+{
+    m_store->setPosition(storeIndex(), x, y);
+}
+
+Tank::Motion Tank::motion() const
+{
+    int index = storeIndex();
+    return {m_store->x(index), m_store->y(index), m_store->speed(index), m_store->direction(index), m_store->flags(index)};
+}
+
+Direction Tank::direction() const
+{
+    return m_store->direction(storeIndex());
+}
+
+double Tank::speed() const
+{
+    return m_store->speed(storeIndex());
+}
+
+void Tank::setSpeed(double speed)
+{
+    m_store->setSpeed(storeIndex(), speed);
+}
+
+bool Tank::stopped() const
+{
+    return m_store->stopped(storeIndex());
+}
+
+void Tank::setStopped(bool stop)
+{
+    m_store->setStopped(storeIndex(), stop);
+}
+
+int Tank::storeIndex() const
+{
+    return m_store->indexOf(m_handle);
 }
 
-bool Tank::testFlag(TankStateFlag flag)
+Direction Tank::facing() const
 {
-    return (m_flags & flag) == flag;
+    int index = storeIndex();
+    return (m_store->flags(index) & TSF_ON_ICE) ? m_store->newDirection(index) : m_store->direction(index);
 }
 
 void Tank::respawn()
 {
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_CREATE);
-    speed = 0.0;
-    stop = false;
-    m_slip_time = 0;
+    int index = storeIndex();
+    m_store->setSprite(index, Engine::getEngine().getSpriteConfig()->getSpriteData(ST_CREATE));
+    m_store->setSpeed(index, 0.0);
+    m_store->setStopped(index, false);
+    m_store->setSlipTime(index, 0);
 
     clearFlag(TSF_SHIELD);
     clearFlag(TSF_BOAT);
-    m_flags = TSF_LIFE;
+    m_store->setFlags(index, TSF_LIFE);
+    m_store->update(index, 0);
     update(0);
-    m_flags = TSF_CREATE; //resetujemy wszystkie inne flagi
+    m_store->setFlags(storeIndex(), TSF_CREATE); //resetujemy wszystkie inne flagi
 
     //ustawienie porostokąta kolizji po wywołaniu update
     collision_rect.x = 0;
@@ -2,66 +2,103 @@
 #define TANK_H
 
 #include "object.h"
-#include "bullet.h"
+#include "bulletstore.h"
+#include "tankstore.h"
 #include "../type.h"
 
 #include <vector>
 
-typedef unsigned TankStateFlags;
-
 /**
  * @brief
  * Klasa zajmująca się podstawową mechaniką czołgów: jazda, strzał.
+ * Stan ruchu czołgu (położenie, kierunek, prędkość, flagi, czasy i klatka animacji) znajduje się w magazynie @a TankStore, który przesuwa wszystkie czołgi jednocześnie;
+ * obiekt czołgu przechowuje uchwyt do tego stanu.
  */
 class Tank : public Object
 {
 public:
+    /**
+     * @brief Położenie, prędkość, kierunek jazdy i flagi czołgu odczytane jednorazowo z magazynu, np. przed sprawdzeniem wielu przeszkód.
+     */
+    struct Motion
+    {
+        double x;
+        double y;
+        double speed;
+        Direction direction;
+        TankStateFlags flags;
+    };
+
     /**
      * Tworzenie czołgu w pierwszym z położeń wrogów.
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @see AppConfig::enemy_starting_point
      */
-    Tank();
+    Tank(TankStore* store);
     /**
      * Tworzenie czołgu
+     * @param store - magazyn stanu czołgów ekranu, na którym jest czołg
      * @param x - pozycja początkowa pozioma
      * @param y - pozycja początkowa pionowa
      * @param type - typ czołgu
      */
-    Tank(double x, double y, SpriteType type);
+    Tank(TankStore* store, double x, double y, SpriteType type);
     virtual ~Tank();
 
     /**
      * Funkcja rysuje obrazek czołgu, w razie potrzeby rysuje osłonkę i łódkę.
-     * Wywołuje rysowanie pocisków.
      */
     void draw();
     /**
-     * Funkcja odpowiada za zmianę położenia czołgu, uaktualnienie położenia prostokątów dest_rect i collision_rect, położenia osłonek i łodzi, animację czołgu,
-     * wywołanie aktualizacji pocisku oraz usuwanie zniszczonych pocisków. Funkcja odlicza czas posiadania osłonki i zamrożenia i wyłącza te flagi.
-     * @param dt - czas od ostatniego wywołania funkcji, wykorzystywany przy zmianie animacji
+     * Funkcja obsługuje wynik kroku czołgu w magazynie (@a TankStore::update), który musi ją poprzedzać: uaktualnia położenie prostokątów dest_rect i collision_rect, położenie osłonek i łodzi,
+     * po zakończeniu animacji wybuchu odradza lub usuwa czołg, oraz usuwa uchwyty pocisków, których wybuch się skończył.
+     * @param dt - czas od ostatniego wywołania funkcji, wykorzystywany przy animacji osłonki i łodzi
      */
     void update(Uint32 dt);
+    /**
+     * Przeniesienie stanu czołgu do innego magazynu, np. przy przejściu gracza do kolejnego ekranu gry.
+     * @param store - nowy magazyn stanu czołgu
+     */
+    void attach(TankStore* store);
     /**
      * Funkcja odpowiada za stworzenie pocisku jeżeli jeszcze nie stworzono maksymalnej ich ilości.
-     * @return wskaźnik na utworzony pocisk, jeżeli nie stworzono pocisku zwraca @a nullptr
+     * @return uchwyt utworzonego pocisku w @a bullet_store, jeżeli nie stworzono pocisku zwraca @a BulletStore::null_handle
+     */
+    virtual BulletStore::Handle fire();
+    /**
+     * Usunięcie wszystkich pocisków czołgu z @a bullet_store i odłączenie czołgu od magazynu pocisków.
      */
-    virtual Bullet* fire();
+    void releaseBullets();
     /**
      * Funkcja zwraca prostokąt kolizji jaki byłby w następnej klatce przy założeniu prędkości i kierunku takiej jaka jest obecnie.
      * @param dt - przewidywany czas wyliczania następnej klatki
      * @return następny prostokąt kolizji
      */
-    SDL_Rect nextCollisionRect(Uint32 dt);
+    SDL_Rect nextCollisionRect(Uint32 dt) const;
+    /**
+     * Funkcja wyznacza odległość, jaką czołg może przejechać w obecnym kierunku zanim dotknie podanej przeszkody.
+     * Przeszkoda, która nie leży na drodze czołgu (jest z boku lub za nim), nie ogranicza ruchu.
+     * @param rect - prostokąt kolizji przeszkody
+     * @return odległość w pikselach lub nieskończoność, jeżeli przeszkoda nie blokuje ruchu
+     */
+    double distanceTo(const SDL_Rect &rect) const;
+    /**
+     * Wersja @a Tank::distanceTo dla stanu ruchu odczytanego wcześniej funkcją @a Tank::motion.
+     * @param rect - prostokąt kolizji przeszkody
+     * @param motion - stan ruchu czołgu
+     * @return odległość w pikselach lub nieskończoność, jeżeli przeszkoda nie blokuje ruchu
+     */
+    double distanceTo(const SDL_Rect &rect, const Motion& motion) const;
     /**
      * Funkcja ustawia następny kierunek ruchu z uwzględnieniem poślizgu na lodzie. Podczas zmiany kierunku następuje dopasowanie czołgu do wielokrotności wymiarów komórki planszy @a AppConfig::tile_rect.
      * @param d - nowy kierunek
      */
     void setDirection(Direction d);
     /**
-     * Funkcja zatrzymuje czołg.
-     * @param intersect_rect - obszar kolizji
+     * Funkcja ogranicza ruch czołgu w bieżącej klatce tak, aby zatrzymał się dokładnie przy przeszkodzie. Zerowa odległość zatrzymuje czołg.
+     * @param distance - odległość do przeszkody wyznaczona przez @a Tank::distanceTo
      */
-    void collide(SDL_Rect &intersect_rect);
+    void collide(double distance);
     /**
      * Funkcja odpowiada za wyczyszczenie wszystkich flag i włączenie animacji powstawania czołgu.
      */
@@ -85,28 +122,51 @@ public:
      * @param flag
      * @return @a true jeżeli flaga jest ustawiona w przeciwnym wypadku @a false
      */
-    bool testFlag(TankStateFlag flag);
-
+    bool testFlag(TankStateFlag flag) const;
     /**
-     * Domyślna prędkość danego czołgu. Może być różna dla różnych typów czołgów lub może być zmieniona po wzięcu bonusu przez gracza.
+     * @return największa liczba pocisków, jakie czołg może mieć jednocześnie
      */
-    double default_speed;
+    unsigned bulletCapacity() const;
+    /**
+     * @return położenie lewego górnego rogu czołgu
+     */
+    double posX() const;
+    double posY() const;
+    /**
+     * Ustawienie położenia czołgu bez zmiany jego prostokątów; prostokąty są przesuwane w funkcji update.
+     */
+    void setPosition(double x, double y);
+    /**
+     * @return położenie, prędkość, kierunek jazdy i flagi czołgu
+     */
+    Motion motion() const;
+    /**
+     * @return aktualny kierunek jazdy czołgu
+     */
+    Direction direction() const;
     /**
      * Aktualna prędkość czołgu.
      */
-    double speed;
+    double speed() const;
+    void setSpeed(double speed);
     /**
-     * Zmienna przechowuję informację czy czołg jest obecnie zatrzymany.
+     * Informacja czy czołg jest obecnie zatrzymany.
      */
-    bool stop;
+    bool stopped() const;
+    void setStopped(bool stop);
+
     /**
-     * Zmeinna przechowuje aktualny kierunek jazdy czołgu.
+     * Domyślna prędkość danego czołgu. Może być różna dla różnych typów czołgów lub może być zmieniona po wzięcu bonusu przez gracza.
      */
-    Direction direction;
+    double default_speed;
     /**
-     * Kontener z wystrzelonymi pociskami czołgu.
+     * Uchwyty wystrzelonych pocisków czołgu w @a bullet_store.
      */
-    std::vector<Bullet*> bullets;
+    std::vector<BulletStore::Handle> bullets;
+    /**
+     * Magazyn pocisków rozgrywki, w której bierze udział czołg; bez magazynu czołg nie strzela.
+     */
+    BulletStore* bullet_store;
     /**
      * Liczba żyć gracza lub numer poziomu pancerza wrogiego czołgu.
      */
@@ -114,38 +174,40 @@ public:
 
 protected:
     /**
-     * Flagi jakie ma aktualnie czołg.
+     * @return położenie stanu czołgu w tablicach @a m_store
      */
-    TankStateFlags m_flags;
+    int storeIndex() const;
     /**
-     * Czas od wystąpienia poślizgu.
+     * @return zwrot czołgu; w poślizgu może być różny od kierunku przemieszczania się czołgu na lodzie
      */
-    Sint32 m_slip_time;
+    Direction facing() const;
+
     /**
-     * Odpowiada zwrotowi czołgu w poślizgu i może być różna od kierunku przemieszczania się czołgu na lodzie.
+     * Magazyn, w którym znajduje się stan ruchu czołgu, i uchwyt tego stanu.
      */
-    Direction new_direction;
+    TankStore* m_store;
+    TankStore::Handle m_handle;
     /**
      * Maksymalna liczba pocisków jakie może wystrzelić czołg.
      */
     unsigned m_bullet_max_size;
 
     /**
-     * Wskaźnik na osłonkę czołgu. Jeśli czołg nie ma osłonki zmienna ma wartośc nullptr;
-     */
-    Object* m_shield;
-    /**
-     * Wskaźnik na łódkę, którą może mieć czołg. Jeśli czołg nie ma łódki zmienna ma wartośc nullptr;
-     */
-    Object* m_boat;
-    /**
-     * Czas od zdobycia osłonki.
+     * Osłonka czołgu. Jest rysowana i aktualizowana tylko przy ustawionej fladze @a TSF_SHIELD.
      */
-    Uint32 m_shield_time;
+    Object m_shield;
     /**
-     * Czas od zamrożenia czoałgu.
+     * Łódka, którą może mieć czołg. Jest rysowana i aktualizowana tylko przy ustawionej fladze @a TSF_BOAT.
      */
-    Uint32 m_frozen_time;
+    Object m_boat;
+
+private:
+    //położenie, obrazek i klatka animacji czołgu są w magazynie; pola obiektu nie są uaktualniane
+    using Object::pos_x;
+    using Object::pos_y;
+    using Object::m_sprite;
+    using Object::m_frame_display_time;
+    using Object::m_current_frame;
 };
 
 #endif // TANK_H
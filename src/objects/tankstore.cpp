@@ -0,0 +1,371 @@
+#include "tankstore.h"
+#include "../engine/engine.h"
+#include "../appconfig.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * Usunięcie elementu tablicy z przeniesieniem ostatniego na jego miejsce, tak jak w @a SlotMap::eraseAt.
+     */
+    template <class T>
+    void removeAt(std::vector<T>& values, unsigned index)
+    {
+        values.at(index) = values.back();
+        values.pop_back();
+    }
+}
+
+void TankStore::reserve(unsigned count)
+{
+    m_flags.reserve(count);
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_speed.reserve(count);
+    m_max_move.reserve(count);
+    m_direction.reserve(count);
+    m_new_direction.reserve(count);
+    m_stop.reserve(count);
+    m_slip_time.reserve(count);
+    m_shield_time.reserve(count);
+    m_frozen_time.reserve(count);
+    m_sprite.reserve(count);
+    m_type.reserve(count);
+    m_frame.reserve(count);
+    m_frame_time.reserve(count);
+    m_events.reserve(count);
+}
+
+TankStore::Handle TankStore::insert(double x, double y, SpriteType type)
+{
+    Handle handle = m_flags.insert(0);
+    if(handle == null_handle) return handle;
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_speed.push_back(0.0);
+    m_max_move.push_back(std::numeric_limits<double>::infinity());
+    m_direction.push_back(D_UP);
+    m_new_direction.push_back(D_UP);
+    m_stop.push_back(false);
+    m_slip_time.push_back(0);
+    m_shield_time.push_back(0);
+    m_frozen_time.push_back(0);
+    m_sprite.push_back(Engine::getEngine().getSpriteConfig()->getSpriteData(type));
+    m_type.push_back(type);
+    m_frame.push_back(0);
+    m_frame_time.push_back(0);
+    m_events.push_back(0);
+    return handle;
+}
+
+TankStore::Handle TankStore::insert(const TankStore& source, unsigned index)
+{
+    Handle handle = m_flags.insert(source.m_flags.at(index));
+    if(handle == null_handle) return handle;
+    m_x.push_back(source.m_x.at(index));
+    m_y.push_back(source.m_y.at(index));
+    m_speed.push_back(source.m_speed.at(index));
+    m_max_move.push_back(source.m_max_move.at(index));
+    m_direction.push_back(source.m_direction.at(index));
+    m_new_direction.push_back(source.m_new_direction.at(index));
+    m_stop.push_back(source.m_stop.at(index));
+    m_slip_time.push_back(source.m_slip_time.at(index));
+    m_shield_time.push_back(source.m_shield_time.at(index));
+    m_frozen_time.push_back(source.m_frozen_time.at(index));
+    m_sprite.push_back(source.m_sprite.at(index));
+    m_type.push_back(source.m_type.at(index));
+    m_frame.push_back(source.m_frame.at(index));
+    m_frame_time.push_back(source.m_frame_time.at(index));
+    m_events.push_back(source.m_events.at(index));
+    return handle;
+}
+
+void TankStore::erase(Handle handle)
+{
+    int index = indexOf(handle);
+    if(index < 0) return;
+
+    removeAt(m_x, index);
+    removeAt(m_y, index);
+    removeAt(m_speed, index);
+    removeAt(m_max_move, index);
+    removeAt(m_direction, index);
+    removeAt(m_new_direction, index);
+    removeAt(m_stop, index);
+    removeAt(m_slip_time, index);
+    removeAt(m_shield_time, index);
+    removeAt(m_frozen_time, index);
+    removeAt(m_sprite, index);
+    removeAt(m_type, index);
+    removeAt(m_frame, index);
+    removeAt(m_frame_time, index);
+    removeAt(m_events, index);
+    m_flags.eraseAt(index);
+}
+
+int TankStore::indexOf(Handle handle) const
+{
+    return m_flags.indexOf(handle);
+}
+
+unsigned TankStore::size() const
+{
+    return m_flags.size();
+}
+
+void TankStore::update(Uint32 dt)
+{
+    step(0, m_flags.size(), dt);
+}
+
+void TankStore::update(unsigned index, Uint32 dt)
+{
+    step(index, index + 1, dt);
+}
+
+void TankStore::step(unsigned begin, unsigned end, Uint32 dt)
+{
+    if(begin >= end) return;
+    //każda pętla zależy tylko od stanu tego samego czołgu, więc kolejność zmian dla czołgu jest taka sama jak przy liczeniu czołgów po kolei
+    TankStateFlags* flags = &*m_flags.begin();
+    double* x = m_x.data();
+    double* y = m_y.data();
+    double* max_move = m_max_move.data();
+    const double* speed = m_speed.data();
+    Uint8* direction = m_direction.data();
+    const Uint8* new_direction = m_new_direction.data();
+    const Uint8* stop = m_stop.data();
+    Sint32* slip_time = m_slip_time.data();
+    Uint32* shield_time = m_shield_time.data();
+    Uint32* frozen_time = m_frozen_time.data();
+    const SpriteData** sprite = m_sprite.data();
+    int* frame = m_frame.data();
+    Uint32* frame_time = m_frame_time.data();
+    Uint8* events = m_events.data();
+
+    //========================ruch========================
+    for(unsigned i = begin; i < end; i++)
+    {
+        events[i] = (flags[i] & TSF_LIFE) ? TE_LIFE : 0;
+        if(!(flags[i] & TSF_LIFE) || stop[i] || (flags[i] & TSF_FROZEN)) continue;
+
+        double distance = speed[i] * dt;
+        bool contact = distance >= max_move[i];
+        if(contact) distance = max_move[i];
+
+        //przy dojeździe do przeszkody pozycja jest dociągana do pełnego piksela, aby błąd zaokrąglenia nie powodował nachodzenia na przeszkodę
+        switch(direction[i])
+        {
+        case D_UP:
+            y[i] -= distance;
+            if(contact) y[i] = std::ceil(y[i] - 1e-6);
+            break;
+        case D_RIGHT:
+            x[i] += distance;
+            if(contact) x[i] = std::floor(x[i] + 1e-6);
+            break;
+        case D_DOWN:
+            y[i] += distance;
+            if(contact) y[i] = std::floor(y[i] + 1e-6);
+            break;
+        case D_LEFT:
+            x[i] -= distance;
+            if(contact) x[i] = std::ceil(x[i] - 1e-6);
+            break;
+        }
+    }
+    for(unsigned i = begin; i < end; i++) max_move[i] = std::numeric_limits<double>::infinity();
+
+    //========================czasy poślizgu, osłonki i zamrożenia========================
+    for(unsigned i = begin; i < end; i++)
+    {
+        if((flags[i] & TSF_ON_ICE) && slip_time[i] > 0)
+        {
+            slip_time[i] -= dt;
+            if(slip_time[i] <= 0)
+            {
+                flags[i] &= ~TSF_ON_ICE;
+                slip_time[i] = 0;
+                direction[i] = new_direction[i];
+            }
+        }
+        if(flags[i] & TSF_SHIELD)
+        {
+            shield_time[i] += dt;
+            if(shield_time[i] > AppConfig::tank_shield_time)
+            {
+                flags[i] &= ~TSF_SHIELD;
+                shield_time[i] = 0;
+            }
+        }
+        if(flags[i] & TSF_FROZEN)
+        {
+            frozen_time[i] += dt;
+            if(frozen_time[i] > AppConfig::tank_frozen_time)
+            {
+                flags[i] &= ~TSF_FROZEN;
+                frozen_time[i] = 0;
+            }
+        }
+    }
+
+    //========================animacja========================
+    for(unsigned i = begin; i < end; i++)
+    {
+        if(sprite[i]->frames_count <= 1 || ((flags[i] & TSF_LIFE) && !(speed[i] > 0))) continue; //brak animacji jeśli czołg nie próbuje jechać
+
+        frame_time[i] += dt;
+        if(frame_time[i] <= ((flags[i] & TSF_MENU) ? sprite[i]->frame_duration / 2 : sprite[i]->frame_duration)) continue;
+
+        frame_time[i] = 0;
+        frame[i]++;
+        if(frame[i] < sprite[i]->frames_count) continue;
+
+        if(sprite[i]->loop) frame[i] = 0;
+        else if(flags[i] & TSF_CREATE)
+        {
+            sprite[i] = Engine::getEngine().getSpriteConfig()->getSpriteData(m_type.at(i));
+            flags[i] &= ~TSF_CREATE;
+            flags[i] |= TSF_LIFE;
+            frame[i] = 0;
+        }
+        else if(flags[i] & TSF_DESTROYED)
+        {
+            frame[i] = sprite[i]->frames_count;
+            events[i] |= TE_DESTROY_FINISHED;
+        }
+    }
+}
+
+double TankStore::x(unsigned index) const
+{
+    return m_x.at(index);
+}
+
+double TankStore::y(unsigned index) const
+{
+    return m_y.at(index);
+}
+
+void TankStore::setPosition(unsigned index, double x, double y)
+{
+    m_x.at(index) = x;
+    m_y.at(index) = y;
+}
+
+Direction TankStore::direction(unsigned index) const
+{
+    return static_cast<Direction>(m_direction.at(index));
+}
+
+void TankStore::setDirection(unsigned index, Direction direction)
+{
+    m_direction.at(index) = direction;
+}
+
+Direction TankStore::newDirection(unsigned index) const
+{
+    return static_cast<Direction>(m_new_direction.at(index));
+}
+
+void TankStore::setNewDirection(unsigned index, Direction direction)
+{
+    m_new_direction.at(index) = direction;
+}
+
+double TankStore::speed(unsigned index) const
+{
+    return m_speed.at(index);
+}
+
+void TankStore::setSpeed(unsigned index, double speed)
+{
+    m_speed.at(index) = speed;
+}
+
+double TankStore::maxMove(unsigned index) const
+{
+    return m_max_move.at(index);
+}
+
+void TankStore::setMaxMove(unsigned index, double distance)
+{
+    m_max_move.at(index) = distance;
+}
+
+bool TankStore::stopped(unsigned index) const
+{
+    return m_stop.at(index) != 0;
+}
+
+void TankStore::setStopped(unsigned index, bool stop)
+{
+    m_stop.at(index) = stop;
+}
+
+TankStateFlags TankStore::flags(unsigned index) const
+{
+    return m_flags.at(index);
+}
+
+void TankStore::setFlags(unsigned index, TankStateFlags flags)
+{
+    m_flags.at(index) = flags;
+}
+
+Sint32 TankStore::slipTime(unsigned index) const
+{
+    return m_slip_time.at(index);
+}
+
+void TankStore::setSlipTime(unsigned index, Sint32 time)
+{
+    m_slip_time.at(index) = time;
+}
+
+Uint32 TankStore::shieldTime(unsigned index) const
+{
+    return m_shield_time.at(index);
+}
+
+void TankStore::setShieldTime(unsigned index, Uint32 time)
+{
+    m_shield_time.at(index) = time;
+}
+
+Uint32 TankStore::frozenTime(unsigned index) const
+{
+    return m_frozen_time.at(index);
+}
+
+void TankStore::setFrozenTime(unsigned index, Uint32 time)
+{
+    m_frozen_time.at(index) = time;
+}
+
+const SpriteData* TankStore::sprite(unsigned index) const
+{
+    return m_sprite.at(index);
+}
+
+void TankStore::setSprite(unsigned index, const SpriteData* sprite)
+{
+    m_sprite.at(index) = sprite;
+}
+
+void TankStore::restartAnimation(unsigned index)
+{
+    m_frame.at(index) = 0;
+    m_frame_time.at(index) = 0;
+}
+
+int TankStore::frame(unsigned index) const
+{
+    return m_frame.at(index);
+}
+
+Uint8 TankStore::events(unsigned index) const
+{
+    return m_events.at(index);
+}
@@ -0,0 +1,156 @@
+#ifndef TANKSTORE_H
+#define TANKSTORE_H
+
+#include "../type.h"
+#include "../engine/slotmap.h"
+#include "../engine/spriteconfig.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+typedef unsigned TankStateFlags;
+
+/**
+ * @brief
+ * Stan ruchu czołgów jednego ekranu gry przechowywany jako struktura tablic: położenie, kierunek, prędkość, flagi, czasy poślizgu, osłonki i zamrożenia oraz klatka animacji mają osobne ciągłe tablice.
+ * Ruch, odliczanie czasów i animacja wszystkich czołgów są liczone kolejnymi pętlami po tablicach (@a TankStore::update) bez wywołań wirtualnych;
+ * obiekt @a Tank przechowuje jedynie uchwyt i odczytuje z magazynu wyniki kroku w swojej funkcji update.
+ * Czołgi są wskazywane uchwytami, a ich położenie w tablicach (indeks) jest ważne do najbliższego wywołania @a TankStore::erase.
+ */
+class TankStore
+{
+public:
+    typedef SlotMap<TankStateFlags>::Handle Handle;
+
+    /**
+     * Zdarzenia ostatniego kroku czołgu, obsługiwane przez obiekt czołgu po kroku magazynu.
+     */
+    enum TankEvent
+    {
+        TE_LIFE = 1, ///< czołg był w trakcie kroku na mapie (@a TSF_LIFE), więc jego prostokąty trzeba przesunąć do nowego położenia
+        TE_DESTROY_FINISHED = 2 ///< skończyła się animacja wybuchu czołgu
+    };
+
+    /**
+     * Uchwyt, który nigdy nie wskazuje na czołg.
+     */
+    static const Handle null_handle = SlotMap<TankStateFlags>::null_handle;
+
+    /**
+     * Rezerwacja pamięci na podaną liczbę czołgów, aby pojawienie się kolejnego nie odwoływało się do sterty.
+     * @param count - liczba czołgów
+     */
+    void reserve(unsigned count);
+    /**
+     * Dodanie stojącego czołgu bez flag, skierowanego w górę.
+     * @param x - pozycja pozioma lewego górnego rogu
+     * @param y - pozycja pionowa lewego górnego rogu
+     * @param type - typ czołgu; wyznacza obrazek po zakończeniu animacji powstawania
+     * @return uchwyt czołgu
+     */
+    Handle insert(double x, double y, SpriteType type);
+    /**
+     * Dodanie kopii stanu czołgu z innego magazynu, np. przy przejściu gracza do kolejnego ekranu gry.
+     * @param source - magazyn, w którym znajduje się czołg
+     * @param index - położenie czołgu w tablicach magazynu @a source
+     * @return uchwyt kopii czołgu
+     */
+    Handle insert(const TankStore& source, unsigned index);
+    /**
+     * Usunięcie czołgu wskazanego uchwytem; na jego miejsce w tablicach trafia ostatni czołg.
+     * @param handle - uchwyt czołgu
+     */
+    void erase(Handle handle);
+    /**
+     * @param handle - uchwyt czołgu
+     * @return położenie czołgu w tablicach lub -1 jeśli uchwyt nie jest ważny
+     */
+    int indexOf(Handle handle) const;
+    unsigned size() const;
+
+    /**
+     * Krok wszystkich czołgów: ruch żywych czołgów ograniczony przez @a maxMove, odliczanie czasu poślizgu, osłonki i zamrożenia z wyłączeniem tych flag oraz animacja.
+     * Wynik kroku dla każdego czołgu jest dostępny przez @a TankStore::events do następnego kroku.
+     * @param dt - czas od ostatniego wywołania funkcji
+     */
+    void update(Uint32 dt);
+    /**
+     * Krok jednego czołgu, taki sam jak w @a TankStore::update(Uint32).
+     * @param index - położenie czołgu w tablicach
+     * @param dt - czas od ostatniego wywołania funkcji
+     */
+    void update(unsigned index, Uint32 dt);
+
+    double x(unsigned index) const;
+    double y(unsigned index) const;
+    void setPosition(unsigned index, double x, double y);
+    /**
+     * Kierunek przemieszczania się czołgu.
+     */
+    Direction direction(unsigned index) const;
+    void setDirection(unsigned index, Direction direction);
+    /**
+     * Zwrot czołgu w poślizgu; po zakończeniu poślizgu staje się kierunkiem przemieszczania.
+     */
+    Direction newDirection(unsigned index) const;
+    void setNewDirection(unsigned index, Direction direction);
+    double speed(unsigned index) const;
+    void setSpeed(unsigned index, double speed);
+    /**
+     * Największa odległość, o jaką czołg może się przesunąć w bieżącym kroku; po kroku wraca do nieskończoności.
+     */
+    double maxMove(unsigned index) const;
+    void setMaxMove(unsigned index, double distance);
+    bool stopped(unsigned index) const;
+    void setStopped(unsigned index, bool stop);
+    TankStateFlags flags(unsigned index) const;
+    void setFlags(unsigned index, TankStateFlags flags);
+    Sint32 slipTime(unsigned index) const;
+    void setSlipTime(unsigned index, Sint32 time);
+    Uint32 shieldTime(unsigned index) const;
+    void setShieldTime(unsigned index, Uint32 time);
+    Uint32 frozenTime(unsigned index) const;
+    void setFrozenTime(unsigned index, Uint32 time);
+    /**
+     * Obecna animacja czołgu; zmiana animacji nie zmienia numeru klatki.
+     */
+    const SpriteData* sprite(unsigned index) const;
+    void setSprite(unsigned index, const SpriteData* sprite);
+    int frame(unsigned index) const;
+    /**
+     * Rozpoczęcie animacji od pierwszej klatki.
+     */
+    void restartAnimation(unsigned index);
+    /**
+     * @return bity @a TankEvent ustawione w ostatnim kroku czołgu
+     */
+    Uint8 events(unsigned index) const;
+
+private:
+    /**
+     * Krok czołgów o indeksach z przedziału [begin, end).
+     */
+    void step(unsigned begin, unsigned end, Uint32 dt);
+
+    /**
+     * Flagi czołgów; kontener nadaje uchwyty i wyznacza kolejność wszystkich pozostałych tablic.
+     */
+    SlotMap<TankStateFlags> m_flags;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_speed;
+    std::vector<double> m_max_move;
+    std::vector<Uint8> m_direction;
+    std::vector<Uint8> m_new_direction;
+    std::vector<Uint8> m_stop;
+    std::vector<Sint32> m_slip_time;
+    std::vector<Uint32> m_shield_time;
+    std::vector<Uint32> m_frozen_time;
+    std::vector<const SpriteData*> m_sprite;
+    std::vector<SpriteType> m_type;
+    std::vector<int> m_frame;
+    std::vector<Uint32> m_frame_time;
+    std::vector<Uint8> m_events;
+};
+
+#endif // TANKSTORE_H
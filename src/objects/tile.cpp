@@ -0,0 +1,86 @@
+#include "tile.h"
+#include "../appconfig.h"
+
+Tile::Tile()
+{
+    type = ST_NONE;
+    state = 0;
+    hits = 0;
+}
+
+Tile::Tile(SpriteType type)
+{
+    this->type = type;
+    state = 0;
+    hits = 0;
+}
+
+bool Tile::empty() const
+{
+    return type == ST_NONE;
+}
+
+SDL_Rect Tile::destRect(int row, int column)
+{
+    return {column * AppConfig::tile_rect.w, row * AppConfig::tile_rect.h, AppConfig::tile_rect.w, AppConfig::tile_rect.h};
+}
+
+SDL_Rect Tile::collisionRect(int row, int column) const
+{
+    SDL_Rect r = destRect(row, column);
+    int half_w = r.w / 2, half_h = r.h / 2;
+
+    switch(state)
+    {
+    case 1: r.h = half_h; break;
+    case 2: r.x += half_w; r.w = half_w; break;
+    case 3: r.y += half_h; r.h = half_h; break;
+    case 4: r.w = half_w; break;
+    case 5: r.x += half_w; r.w = half_w; r.h = half_h; break;
+    case 6: r.x += half_w; r.y += half_h; r.w = half_w; r.h = half_h; break;
+    case 7: r.w = half_w; r.h = half_h; break;
+    case 8: r.y += half_h; r.w = half_w; r.h = half_h; break;
+    case 9: r = {0, 0, 0, 0}; break;
+    }
+    return r;
+}
+
+void Tile::draw(int row, int column, int frame) const
+{
+    if(empty()) return;
+
+    const SpriteData* sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(static_cast<SpriteType>(type));
+    //murek ma osobną klatkę dla każdego stanu, pozostałe pola mogą być animowane
+    int src_frame = type == ST_BRICK_WALL ? state : frame % sprite->frames_count;
+    SDL_Rect src = {sprite->rect.x, sprite->rect.y + src_frame * sprite->rect.h, sprite->rect.w, sprite->rect.h};
+    SDL_Rect dest = destRect(row, column);
+    Engine::getEngine().getRenderer()->drawObject(&src, &dest);
+}
+
+void Tile::bulletHit(Direction bullet_direction)
+{
+    int bd = bullet_direction;
+    hits++;
+    if(hits == 1)
+    {
+        state = bd + 1;
+    }
+    else if(hits == 2)
+    {
+        int sum_square = (state - 1) * (state - 1) + bd * bd;
+        if(sum_square % 2 == 1)
+        {
+            state = ((double)sum_square + 19.0) / 4.0;
+        }
+        else
+        {
+            state = 9;
+        }
+    }
+    else
+    {
+        state = 9;
+    }
+
+    if(state == 9) *this = Tile();
+}
@@ -0,0 +1,69 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include "../engine/engine.h"
+#include "../type.h"
+
+/**
+ * @brief
+ * Zwarty opis jednego pola mapy (murku, kamiennego muru, wody lub lodu).
+ * Pole nie przechowuje swojego położenia ani prostokątów; są one wyznaczane na żądanie z numeru wiersza i kolumny pola oraz stanu murku.
+ */
+struct Tile
+{
+    /**
+     * Tworzenie pustego pola.
+     */
+    Tile();
+    /**
+     * Tworzenie nienaruszonego pola danego rodzaju.
+     * @param type - rodzaj pola
+     */
+    Tile(SpriteType type);
+
+    /**
+     * @return true jeśli na polu nie ma przeszkody
+     */
+    bool empty() const;
+    /**
+     * Wyznaczenie prostokąta kolizji pola; dla uszkodzonego murku jest to jego pozostała część.
+     * @param row - wiersz pola
+     * @param column - kolumna pola
+     * @return prostokąt kolizji
+     */
+    SDL_Rect collisionRect(int row, int column) const;
+    /**
+     * Wyznaczenie prostokąta pola na mapie.
+     * @param row - wiersz pola
+     * @param column - kolumna pola
+     * @return prostokąt, w którym rysowane jest pole
+     */
+    static SDL_Rect destRect(int row, int column);
+    /**
+     * Rysowanie pola.
+     * @param row - wiersz pola
+     * @param column - kolumna pola
+     * @param frame - numer klatki animacji dla pól animowanych (wody)
+     */
+    void draw(int row, int column, int frame) const;
+    /**
+     * Zmiana stanu murku po trafieniu przez pocisk. Zniszczony murek staje się pustym polem.
+     * @param bullet_direction - kierunek ruchu pocisku
+     */
+    void bulletHit(Direction bullet_direction);
+
+    /**
+     * Rodzaj pola; wartość @a ST_NONE oznacza puste pole.
+     */
+    Uint8 type;
+    /**
+     * Jeden z dziesięciu stanów w jakich może być murek; dla pozostałych pól zawsze 0.
+     */
+    Uint8 state;
+    /**
+     * Liczba trafień pocisków w murek.
+     */
+    Uint8 hits;
+};
+
+#endif // TILE_H
@@ -0,0 +1,169 @@
+/**
+ * Narzędzie przygotowujące zasoby graficzne w postaci gotowej do użycia przy starcie programu.
+ * Użycie: assetbake <tekstura.png> <czcionka.ttf> <plik_wyjściowy> <rozmiar_czcionki>...
+ * Tekstura jest dekodowana do formatu SDL_PIXELFORMAT_ABGR8888, a czcionka jest rysowana w każdym z podanych rozmiarów
+ * jako arkusz znaków ASCII od spacji do tyldy.
+ * @see AssetPack
+ */
+
+#define SDL_MAIN_HANDLED
+#include "../src/engine/assetpack.h"
+#include "../src/engine/mappedfile.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/**
+ * Zakodowanie tekstury.
+ * @param path - ścieżka do pliku PNG
+ * @param out - plik wyjściowy
+ * @return true jeśli udało się wczytać teksturę
+ */
+static bool bakeImage(const char* path, std::ofstream& out)
+{
+    SDL_Surface* loaded = IMG_Load(path);
+    if(loaded == nullptr) return false;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ABGR8888, 0);
+    SDL_FreeSurface(loaded);
+    if(surface == nullptr) return false;
+
+    AssetPack::ImageHeader header;
+    header.width = surface->w;
+    header.height = surface->h;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    SDL_LockSurface(surface);
+    for(int y = 0; y < surface->h; y++)
+        out.write(static_cast<const char*>(surface->pixels) + y * surface->pitch, surface->w * 4);
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+/**
+ * Narysowanie czcionki w jednym rozmiarze.
+ * Każdy znak jest rysowany funkcją TTF_RenderText_Solid, tak jak tekst rysowany bezpośrednio z czcionki TTF w Renderer::drawText,
+ * więc tekst złożony ze znaków arkusza wygląda tak samo.
+ * @param path - ścieżka do pliku TTF
+ * @param point_size - rozmiar czcionki
+ * @param out - plik wyjściowy
+ * @return true jeśli udało się narysować wszystkie znaki
+ */
+static bool bakeFont(const char* path, int point_size, std::ofstream& out)
+{
+    TTF_Font* font = TTF_OpenFont(path, point_size);
+    if(font == nullptr) return false;
+
+    SDL_Color white = {255, 255, 255, 255};
+    int height = TTF_FontHeight(font);
+    std::vector<SDL_Surface*> surfaces(AssetPack::glyphs_count, nullptr);
+    std::vector<AssetPack::Glyph> glyphs(AssetPack::glyphs_count);
+    int sheet_width = 0;
+    bool valid = true;
+    for(int i = 0; i < AssetPack::glyphs_count && valid; i++)
+    {
+        char text[2] = {static_cast<char>(AssetPack::first_glyph + i), '\0'};
+        surfaces.at(i) = TTF_RenderText_Solid(font, text, white);
+        valid = surfaces.at(i) != nullptr && surfaces.at(i)->format->BitsPerPixel == 8 && sheet_width + surfaces.at(i)->w <= 0xFFFF;
+        if(!valid) break;
+        glyphs.at(i).x = sheet_width;
+        glyphs.at(i).width = surfaces.at(i)->w;
+        glyphs.at(i).advance = surfaces.at(i)->w;
+        glyphs.at(i).reserved = 0;
+        sheet_width += surfaces.at(i)->w;
+    }
+
+    if(valid)
+    {
+        //TTF_RenderText_Solid zwraca powierzchnię z paletą, w której indeks 0 jest przezroczystym tłem
+        std::vector<Uint8> alpha(static_cast<std::size_t>(sheet_width) * height, 0);
+        for(int i = 0; i < AssetPack::glyphs_count; i++)
+        {
+            SDL_Surface* surface = surfaces.at(i);
+            SDL_LockSurface(surface);
+            for(int y = 0; y < surface->h && y < height; y++)
+            {
+                const Uint8* src = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+                for(int x = 0; x < surface->w; x++)
+                    if(src[x] != 0) alpha.at(y * sheet_width + glyphs.at(i).x + x) = 255;
+            }
+            SDL_UnlockSurface(surface);
+        }
+
+        AssetPack::FontHeader header;
+        header.point_size = point_size;
+        header.height = height;
+        header.sheet_width = sheet_width;
+        header.reserved = 0;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(glyphs.data()), glyphs.size() * sizeof(AssetPack::Glyph));
+        out.write(reinterpret_cast<const char*>(alpha.data()), alpha.size());
+    }
+
+    for(auto surface : surfaces) SDL_FreeSurface(surface);
+    TTF_CloseFont(font);
+    return valid;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 5)
+    {
+        std::cerr << "usage: assetbake <texture.png> <font.ttf> <output> <font_size>..." << std::endl;
+        return 1;
+    }
+    SDL_SetMainReady();
+    if(SDL_Init(0) != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) || TTF_Init() == -1)
+    {
+        std::cerr << "assetbake: cannot initialize SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    //plik zasobów jest zapisywany pod nazwą tymczasową, bo uruchomiona gra może mieć poprzedni odwzorowany w pamięci
+    std::string output = argv[3];
+    std::string temp_output = output + ".tmp";
+    std::ofstream out(temp_output, std::ios::binary);
+    AssetPack::Header header;
+    header.magic = AssetPack::magic;
+    header.version = AssetPack::version;
+    header.fonts_count = argc - 4;
+    header.reserved = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    int result = 0;
+    if(!bakeImage(argv[1], out))
+    {
+        std::cerr << "assetbake: cannot read " << argv[1] << ": " << SDL_GetError() << std::endl;
+        result = 1;
+    }
+    for(int i = 4; i < argc && result == 0; i++)
+    {
+        int point_size = atoi(argv[i]);
+        if(point_size <= 0 || !bakeFont(argv[2], point_size, out))
+        {
+            std::cerr << "assetbake: cannot render " << argv[2] << " at size " << argv[i] << ": " << SDL_GetError() << std::endl;
+            result = 1;
+        }
+    }
+    if(result == 0 && !out)
+    {
+        std::cerr << "assetbake: cannot write " << temp_output << std::endl;
+        result = 1;
+    }
+    out.close();
+    if(result != 0) std::remove(temp_output.c_str());
+    else if(!MappedFile::replace(temp_output, output))
+    {
+        std::cerr << "assetbake: cannot replace " << output << std::endl;
+        result = 1;
+    }
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return result;
+}
@@ -0,0 +1,199 @@
+/**
+ * Narzędzie mierzące czas faz aktualizacji rundy (wykrywanie i rozstrzyganie kontaktów, ograniczenia ruchu czołgów, decyzje przeciwników)
+ * na dużej losowej mapie z wieloma przeciwnikami i ich pociskami, kolejno dla każdej podanej liczby wątków puli.
+ * Użycie: gamebench [--parallel-ai] <kolumny> <wiersze> <przeciwnicy> <klatki> [liczba_wątków ...]
+ *         gamebench --stores <czołgi> <pociski> <klatki>
+ * Opcja --parallel-ai, tak jak w grze, włącza równoległe wyznaczanie decyzji przeciwników (@a AppConfig::parallel_ai_decisions).
+ * Bez podanych liczb wątków pomiar jest wykonywany dla 1, 2, 4, 8 i 16 wątków. Jeden wątek oznacza wykonanie szeregowe (@a ThreadPool bez wątków roboczych).
+ * Każdy pomiar zaczyna się od tego samego ziarna, a przebieg rundy nie zależy od liczby wątków, więc wszystkie pomiary dotyczą tych samych klatek.
+ * Czasy są podawane w mikrosekundach na klatkę jako średnia z mierzonych klatek po rozgrzaniu rundy.
+ * Tryb --stores mierzy jedynie kroki magazynów stanu (@a TankStore::update i @a BulletStore::update) dla podanej liczby jadących czołgów i lecących pocisków, bez mapy i kolizji.
+ * @see Game::PhaseTimes
+ */
+
+#include "../src/app_state/game.h"
+#include "../src/objects/tankstore.h"
+#include "../src/objects/bulletstore.h"
+#include "../src/engine/engine.h"
+#include "../src/appconfig.h"
+#include <SDL2/SDL.h>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * Długość klatki w milisekundach.
+ */
+static const Uint32 frame_time = 16;
+
+/**
+ * Ustawienie rozmiaru mapy, położeń startowych i liczby przeciwników; położenia wrogów są rozłożone co cztery kolumny w górnym wierszu mapy.
+ */
+static void configure(int columns, int rows, int enemies)
+{
+    int w = AppConfig::tile_rect.w, h = AppConfig::tile_rect.h;
+    AppConfig::map_rect = {0, 0, columns * w, rows * h};
+    AppConfig::enemy_starting_point.clear();
+    for(int column = 0; column + 1 < columns; column += 4) AppConfig::enemy_starting_point.push_back({column * w, 0});
+    AppConfig::player_starting_point = {{8 * w, (rows - 2) * h}, {16 * w, (rows - 2) * h}};
+
+    AppConfig::enemy_max_count_on_map = enemies;
+    AppConfig::enemy_redy_time = 0;
+    AppConfig::enemy_start_count = 1000000;
+    AppConfig::generated_levels = true;
+    AppConfig::generator_seed = 1;
+}
+
+/**
+ * Jeden pomiar: runda rozgrzewana do zapełnienia mapy przeciwnikami, a następnie @a ticks mierzonych klatek.
+ * @return czasy faz zmierzonych klatek
+ */
+static Game::PhaseTimes measure(unsigned threads, int enemies, int ticks, double& update_time)
+{
+    AppConfig::worker_threads = threads;
+    Engine& engine = Engine::getEngine();
+    engine.initModules();
+    srand(1);
+
+    //gracze nie tracą wszystkich żyć, aby przeciwnicy mieli cel przez cały pomiar; rozgrywka przenosi ich stan do własnego magazynu
+    TankStore tanks;
+    std::vector<Player*> players;
+    for(unsigned i = 0; i < 2; i++)
+    {
+        SDL_Point start = AppConfig::player_starting_point.at(i);
+        Player* player = new Player(&tanks, start.x, start.y, i == 0 ? ST_PLAYER_1 : ST_PLAYER_2);
+        player->player_keys = AppConfig::player_keys.at(i);
+        player->lives_count = 1000000;
+        players.push_back(player);
+    }
+    Game* game = new Game(players, 0);
+
+    int warmup = AppConfig::level_start_time / frame_time + 2 * enemies + 200;
+    for(int i = 0; i < warmup; i++)
+    {
+        engine.getFrameArena()->reset();
+        game->update(frame_time);
+    }
+
+    game->resetPhaseTimes();
+    Uint64 start = SDL_GetPerformanceCounter();
+    for(int i = 0; i < ticks && !game->finished(); i++)
+    {
+        engine.getFrameArena()->reset();
+        game->update(frame_time);
+    }
+    Game::PhaseTimes times = game->phaseTimes();
+    update_time = static_cast<double>(SDL_GetPerformanceCounter() - start);
+
+    delete game;
+    engine.destroyModules();
+    return times;
+}
+
+/**
+ * Pomiar kroków magazynów stanu czołgów i pocisków. Czołgi jadą w czterech kierunkach, co czwarty ma osłonkę, a co ósmy jest na lodzie; pociski lecą przez cały pomiar.
+ */
+static void measureStores(int tanks_count, int bullets_count, int ticks)
+{
+    AppConfig::worker_threads = 1;
+    Engine& engine = Engine::getEngine();
+    engine.initModules();
+    double us = 1000000.0 / SDL_GetPerformanceFrequency();
+    {
+        TankStore tanks;
+        tanks.reserve(tanks_count);
+        for(int i = 0; i < tanks_count; i++)
+        {
+            TankStore::Handle handle = tanks.insert((i % 64) * 32, (i / 64) * 32, static_cast<SpriteType>(ST_TANK_A + i % 4));
+            int index = tanks.indexOf(handle);
+            TankStateFlags flags = TSF_LIFE;
+            if(i % 4 == 0) flags |= TSF_SHIELD;
+            if(i % 8 == 1) flags |= TSF_ON_ICE;
+            tanks.setFlags(index, flags);
+            tanks.setDirection(index, static_cast<Direction>(i % 4));
+            tanks.setNewDirection(index, static_cast<Direction>((i + 1) % 4));
+            tanks.setSlipTime(index, AppConfig::slip_time);
+            tanks.setSpeed(index, AppConfig::tank_default_speed);
+        }
+        BulletStore bullets;
+        bullets.reserve(bullets_count);
+        for(int i = 0; i < bullets_count; i++)
+            bullets.insert((i % 128) * 8, (i / 128) * 8, static_cast<Direction>(i % 4), AppConfig::bullet_default_speed);
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        for(int i = 0; i < ticks; i++) tanks.update(frame_time);
+        double tanks_time = static_cast<double>(SDL_GetPerformanceCounter() - start) * us / ticks;
+        start = SDL_GetPerformanceCounter();
+        for(int i = 0; i < ticks; i++) bullets.update(frame_time);
+        double bullets_time = static_cast<double>(SDL_GetPerformanceCounter() - start) * us / ticks;
+
+        std::cout << tanks_count << " tanks, " << bullets_count << " bullets, " << ticks << " ticks" << std::endl;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "TankStore::update   " << std::setw(10) << tanks_time << " us per tick"
+                  << std::setw(10) << tanks_time * 1000 / tanks_count << " ns per tank" << std::endl;
+        std::cout << "BulletStore::update " << std::setw(10) << bullets_time << " us per tick"
+                  << std::setw(10) << bullets_time * 1000 / bullets_count << " ns per bullet" << std::endl;
+    }
+    engine.destroyModules();
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc > 1 && std::strcmp(argv[1], "--stores") == 0)
+    {
+        int tanks_count = argc > 2 ? atoi(argv[2]) : 0, bullets_count = argc > 3 ? atoi(argv[3]) : 0, ticks = argc > 4 ? atoi(argv[4]) : 0;
+        if(tanks_count <= 0 || bullets_count <= 0 || ticks <= 0)
+        {
+            std::cerr << "usage: gamebench --stores <tanks> <bullets> <ticks>" << std::endl;
+            return 1;
+        }
+        measureStores(tanks_count, bullets_count, ticks);
+        return 0;
+    }
+
+    int first = 1;
+    if(argc > 1 && std::strcmp(argv[1], "--parallel-ai") == 0)
+    {
+        AppConfig::parallel_ai_decisions = true;
+        first++;
+    }
+    if(argc < first + 4)
+    {
+        std::cerr << "usage: gamebench [--parallel-ai] <columns> <rows> <enemies> <ticks> [threads ...]" << std::endl;
+        std::cerr << "       gamebench --stores <tanks> <bullets> <ticks>" << std::endl;
+        return 1;
+    }
+    int columns = atoi(argv[first]), rows = atoi(argv[first + 1]), enemies = atoi(argv[first + 2]), ticks = atoi(argv[first + 3]);
+    if(columns < 26 || rows < 4 || enemies <= 0 || ticks <= 0)
+    {
+        std::cerr << "gamebench: the map must have at least 26 columns and 4 rows, enemies and ticks must be positive" << std::endl;
+        return 1;
+    }
+    std::vector<unsigned> threads_counts;
+    for(int i = first + 4; i < argc; i++) threads_counts.push_back(atoi(argv[i]));
+    if(threads_counts.empty()) threads_counts = {1, 2, 4, 8, 16};
+
+    configure(columns, rows, enemies);
+    double us = 1000000.0 / SDL_GetPerformanceFrequency();
+    std::cout << "map " << columns << "x" << rows << ", " << enemies << " enemies, " << ticks << " ticks, "
+              << SDL_GetCPUCount() << " logical CPUs, " << (AppConfig::parallel_ai_decisions ? "parallel" : "serial") << " enemy decisions" << std::endl;
+    std::cout << "time per tick (us):" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(10) << "contacts" << std::setw(10) << "resolve"
+              << std::setw(10) << "limits" << std::setw(10) << "ai" << std::setw(10) << "update" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for(auto threads : threads_counts)
+    {
+        double update_time;
+        Game::PhaseTimes times = measure(threads, enemies, ticks, update_time);
+        double count = times.updates > 0 ? times.updates : 1;
+        std::cout << std::setw(8) << threads
+                  << std::setw(10) << times.detect_contacts * us / count
+                  << std::setw(10) << times.resolve_contacts * us / count
+                  << std::setw(10) << times.tank_limits * us / count
+                  << std::setw(10) << times.enemy_decisions * us / count
+                  << std::setw(10) << update_time * us / count << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Narzędzie tworzące paczkę poziomów z tekstowych plików poziomów.
+ * Użycie: levelpack <katalog_poziomów> <liczba_poziomów> <plik_paczki>
+ * Poziomy są czytane z plików o nazwach 0, 1, ..., liczba_poziomów - 1.
+ * Paczka jest zapisywana do pliku tymczasowego, który zastępuje poprzednią paczkę dopiero po zapisaniu całości, bo uruchomiona gra może mieć ją odwzorowaną w pamięci.
+ * @see LevelPack
+ */
+
+#include "../src/engine/levelpack.h"
+#include "../src/engine/mappedfile.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if(argc != 4)
+    {
+        std::cerr << "usage: levelpack <levels_dir> <levels_count> <output>" << std::endl;
+        return 1;
+    }
+    std::string levels_dir = argv[1];
+    int levels_count = atoi(argv[2]);
+    if(levels_count <= 0)
+    {
+        std::cerr << "levelpack: invalid levels count " << argv[2] << std::endl;
+        return 1;
+    }
+    if(!levels_dir.empty() && levels_dir.back() != '/') levels_dir += '/';
+
+    std::vector<LevelPack::Entry> entries(levels_count);
+    std::vector<char> data;
+    std::size_t data_offset = LevelPack::header_size + levels_count * LevelPack::entry_size;
+    for(int i = 0; i < levels_count; i++)
+    {
+        LevelData level;
+        std::string path = levels_dir + std::to_string(i);
+        if(!LevelPack::readText(path, level))
+        {
+            std::cerr << "levelpack: cannot read " << path << std::endl;
+            return 1;
+        }
+        if(level.rows_count > 0xFFFF || level.columns_count > 0xFFFF || level.player_starts.size() > 0xFFFF
+           || level.enemy_spawns.size() > 0xFFFF || level.roster.size() > 0xFFFF)
+        {
+            std::cerr << "levelpack: level " << path << " is too large" << std::endl;
+            return 1;
+        }
+        std::size_t record_start = data.size();
+        LevelPack::serialize(level, data);
+        entries.at(i).offset = data_offset + record_start;
+        entries.at(i).size = data.size() - record_start;
+    }
+
+    //suma kontrolna obejmuje tablicę poziomów i rekordy poziomów
+    std::vector<char> body;
+    for(auto& entry : entries) LevelPack::serializeEntry(entry, body);
+    body.insert(body.end(), data.begin(), data.end());
+
+    LevelPack::Header header;
+    header.magic = LevelPack::magic;
+    header.version = LevelPack::version;
+    header.levels_count = levels_count;
+    header.checksum = LevelPack::checksum(body.data(), body.size());
+
+    std::vector<char> file;
+    LevelPack::serializeHeader(header, file);
+    file.insert(file.end(), body.begin(), body.end());
+
+    std::string output = argv[3];
+    std::string temp_output = output + ".tmp";
+    std::ofstream out(temp_output, std::ios::binary);
+    out.write(file.data(), file.size());
+    out.close();
+    if(!out)
+    {
+        std::cerr << "levelpack: cannot write " << temp_output << std::endl;
+        std::remove(temp_output.c_str());
+        return 1;
+    }
+    if(!MappedFile::replace(temp_output, output))
+    {
+        std::cerr << "levelpack: cannot replace " << output << std::endl;
+        return 1;
+    }
+    return 0;
+}